@@ -0,0 +1,119 @@
+/**
+ * 数字解码的基准测试，对比sscanf和cave_jsonc_get_double/cave_jsonc_get_integer
+ * 编译：cc -O2 -I.. bench_number.c ../cavejsonc.c -o bench_number
+ * 用法：./bench_number [数字个数]
+ */
+#include "cavejsonc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+static uint64_t state = 88172645463325252ull;
+
+static uint64_t next_random() {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * 生成类似遥测数据的数字：坐标、测量值、时间戳和任意double
+ */
+static char *make_double(char *out) {
+	double d;
+	uint64_t bits;
+	switch(next_random() % 4) {
+		case 0:
+			sprintf(out, "%.6f", (double) (next_random() % 360000000) / 1e6 - 180);
+			break;
+		case 1:
+			sprintf(out, "%.3f", (double) (next_random() % 100000000) / 1e3);
+			break;
+		case 2:
+			sprintf(out, "%.4e", (double) (next_random() % 1000000) * 1e-3);
+			break;
+		default:
+			do {
+				bits = next_random();
+				memcpy(&d, &bits, sizeof(d));
+			} while(d != d || d - d != 0);
+			sprintf(out, "%.17g", d);
+	}
+	return out;
+}
+
+static char *make_integer(char *out) {
+	long long i = (long long) next_random();
+	sprintf(out, "%lld", i >> (next_random() % 63));
+	return out;
+}
+
+static void run(const char *name, char *(*make)(char *), int integer, size_t count) {
+	char **texts = malloc(count * sizeof(char *));
+	size_t bytes = 0;
+	for(size_t i = 0; i < count; i++) {
+		char head[64];
+		texts[i] = strdup(make(head));
+		bytes += strlen(texts[i]);
+	}
+	cave_jsonc_document doc = cave_jsonc_create_document_with_flags(CAVE_JSONC_DOCUMENT_ARENA);
+	cave_jsonc_value *values = malloc(count * sizeof(cave_jsonc_value));
+	for(size_t i = 0; i < count; i++)
+		values[i] = cave_jsonc_create_number_value(doc, texts[i], CAVE_JSONC_STRING_LIFECYCLE_NONE);
+
+	double sum_scanf = 0, sum_cave = 0, start = now();
+	for(size_t i = 0; i < count; i++) {
+		if(integer) {
+			long long v;
+			sscanf(texts[i], "%lld", &v);
+			sum_scanf += v;
+		} else {
+			double v;
+			sscanf(texts[i], "%lf", &v);
+			sum_scanf += v;
+		}
+	}
+	double time_scanf = now() - start;
+	start = now();
+	for(size_t i = 0; i < count; i++)
+		sum_cave += integer ? cave_jsonc_get_integer(values[i]) : cave_jsonc_get_double(values[i]);
+	double time_cave = now() - start;
+
+	size_t mismatches = 0;
+	for(size_t i = 0; i < count; i++) {
+		if(integer) {
+			mismatches += cave_jsonc_get_integer(values[i]) != strtoll(texts[i], NULL, 10);
+		} else {
+			double expected = strtod(texts[i], NULL), actual = cave_jsonc_get_double(values[i]);
+			mismatches += memcmp(&expected, &actual, sizeof(double)) != 0;
+		}
+	}
+	printf("%s: %zu numbers, %.1f MB\n", name, count, bytes / 1e6);
+	printf("  sscanf     %8.3fs %8.1f MB/s\n", time_scanf, bytes / 1e6 / time_scanf);
+	printf("  cave_jsonc %8.3fs %8.1f MB/s  %.2fx  mismatches %zu\n", time_cave, bytes / 1e6 / time_cave, time_scanf / time_cave, mismatches);
+	if(sum_scanf != sum_cave)
+		printf("  checksum differs: %.17g %.17g\n", sum_scanf, sum_cave);
+
+	cave_jsonc_release_all_nodes_in_document(doc);
+	cave_jsonc_release_document(doc);
+	for(size_t i = 0; i < count; i++)
+		free(texts[i]);
+	free(texts);
+	free(values);
+}
+
+int main(int argc, char **argv) {
+	size_t count = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	run("double", make_double, 0, count);
+	run("integer", make_integer, 1, count);
+	return 0;
+}
@@ -0,0 +1,582 @@
+/**
+ * 解析、序列化、数字转换和遍历的基准测试
+ * 编译：make，分配统计依赖GNU ld的--wrap，见Makefile
+ * 用法：./bench_suite [-s 每种输入的MB数] [-r 重复次数] [-j] [文件...]
+ * 默认输出表格，-j时每个结果输出一行JSON，方便保存后对比两次运行
+ * 命令行给出的文件作为真实输入加入语料，其余输入是生成的
+ */
+#include "cavejsonc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * 统计计时期间的分配次数和字节数，链接时用--wrap把malloc等换成下面的函数
+ * fputc形式的序列化中输出缓冲区自身的扩展也计算在内
+ */
+static size_t allocations, allocated_bytes;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+	allocations++;
+	allocated_bytes += size;
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+	allocations++;
+	allocated_bytes += count * size;
+	return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	allocations++;
+	allocated_bytes += size;
+	return __real_realloc(ptr, size);
+}
+
+static uint64_t state = 88172645463325252ull;
+
+static uint64_t next_random() {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * 峰值RSS，单位KB，/proc不可用时用ru_maxrss
+ * 每项测试在fork出的子进程中运行，子进程的峰值从fork时的RSS开始，不受之前测试的影响
+ */
+static long peak_rss() {
+	FILE *file = fopen("/proc/self/status", "r");
+	char line[256];
+	long kb = -1;
+	while(file && fgets(line, sizeof(line), file))
+		if(!strncmp(line, "VmHWM:", 6))
+			kb = atol(line + 6);
+	if(file)
+		fclose(file);
+	if(kb < 0) {
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		kb = usage.ru_maxrss;
+	}
+	return kb;
+}
+
+/**
+ * 可以自动扩展的输出缓冲区，生成语料和fputc形式的序列化都用它
+ */
+struct buffer {
+	char *data;
+	size_t size, cap;
+};
+
+static void put(struct buffer *b, const char *s, size_t length) {
+	if(b->size + length + 1 > b->cap) {
+		while(b->size + length + 1 > b->cap)
+			b->cap = b->cap ? b->cap * 2 : 4096;
+		b->data = realloc(b->data, b->cap);
+	}
+	memcpy(b->data + b->size, s, length);
+	b->size += length;
+	b->data[b->size] = '\0';
+}
+
+static void puts_buffer(struct buffer *b, const char *s) {
+	put(b, s, strlen(s));
+}
+
+static int buffer_putc(int c, void *file) {
+	char ch = c;
+	put(file, &ch, 1);
+	return c;
+}
+
+struct reader {
+	const char *p, *end;
+};
+
+static int reader_getc(void *file) {
+	struct reader *r = file;
+	return r->p < r->end ? (unsigned char) *r->p++ : EOF;
+}
+
+static void random_word(struct buffer *b, size_t length) {
+	char word[64];
+	for(size_t i = 0; i < length; i++)
+		word[i] = 'a' + next_random() % 26;
+	put(b, word, length);
+}
+
+static void random_number(struct buffer *b) {
+	char text[64];
+	switch(next_random() % 3) {
+		case 0:
+			sprintf(text, "%lld", (long long) (next_random() >> (next_random() % 63)));
+			break;
+		case 1:
+			sprintf(text, "%.6f", (double) (next_random() % 360000000) / 1e6 - 180);
+			break;
+		default:
+			sprintf(text, "%.4e", (double) (next_random() % 1000000) * 1e-3);
+	}
+	puts_buffer(b, text);
+}
+
+/**
+ * 配置文件风格的JSONC：每个成员前都有行注释，隔几个有块注释
+ */
+static void make_comments(struct buffer *b, size_t size) {
+	puts_buffer(b, "{\n");
+	for(size_t i = 0; b->size < size; i++) {
+		if(i)
+			puts_buffer(b, ",\n");
+		puts_buffer(b, "\t// ");
+		random_word(b, 40);
+		puts_buffer(b, "\n");
+		if(i % 4 == 0) {
+			puts_buffer(b, "\t/*\n\t * ");
+			random_word(b, 60);
+			puts_buffer(b, "\n\t */\n");
+		}
+		char key[32];
+		sprintf(key, "\t\"option_%zu\": ", i);
+		puts_buffer(b, key);
+		if(i % 2) {
+			puts_buffer(b, "\"");
+			random_word(b, 12);
+			puts_buffer(b, "\"");
+		} else {
+			random_number(b);
+		}
+	}
+	puts_buffer(b, "\n}\n");
+}
+
+static void make_numbers(struct buffer *b, size_t size) {
+	puts_buffer(b, "[");
+	for(size_t i = 0; b->size < size; i++) {
+		if(i)
+			puts_buffer(b, i % 16 ? "," : ",\n");
+		random_number(b);
+	}
+	puts_buffer(b, "]\n");
+}
+
+/**
+ * 反复嵌套到一定深度再回到顶层，避免超过解析器的深度限制
+ */
+static void make_deep(struct buffer *b, size_t size) {
+	puts_buffer(b, "[");
+	for(size_t i = 0; b->size < size; i++) {
+		if(i)
+			puts_buffer(b, ",");
+		for(int d = 0; d < 256; d++)
+			puts_buffer(b, d % 2 ? "[" : "{\"k\":");
+		puts_buffer(b, "1");
+		for(int d = 255; d >= 0; d--)
+			puts_buffer(b, d % 2 ? "]" : "}");
+	}
+	puts_buffer(b, "]\n");
+}
+
+/**
+ * 长字符串，少量转义和多字节字符
+ */
+static void make_strings(struct buffer *b, size_t size) {
+	puts_buffer(b, "[");
+	for(size_t i = 0; b->size < size; i++) {
+		if(i)
+			puts_buffer(b, ",\n");
+		puts_buffer(b, "\"");
+		size_t length = 1024 + next_random() % 8192;
+		for(size_t n = 0; n < length; n += 40) {
+			random_word(b, 32);
+			puts_buffer(b, next_random() % 8 ? " text中文 " : "\\n\\t\\\"");
+		}
+		puts_buffer(b, "\"");
+	}
+	puts_buffer(b, "]\n");
+}
+
+/**
+ * 每个对象有上千个成员，查找和建索引的路径都会用到
+ */
+static void make_wide(struct buffer *b, size_t size) {
+	puts_buffer(b, "[");
+	for(size_t i = 0; b->size < size; i++) {
+		if(i)
+			puts_buffer(b, ",\n");
+		puts_buffer(b, "{");
+		for(int k = 0; k < 2000; k++) {
+			char key[48];
+			sprintf(key, "%s\"field_%d_%llu\":", k ? "," : "", k, (unsigned long long) next_random() % 1000);
+			puts_buffer(b, key);
+			random_number(b);
+		}
+		puts_buffer(b, "}");
+	}
+	puts_buffer(b, "]\n");
+}
+
+/**
+ * 类似接口返回的记录：嵌套的对象、数组、布尔、null和各种数字混在一起
+ */
+static void make_records(struct buffer *b, size_t size) {
+	puts_buffer(b, "{\"status\": \"ok\", \"items\": [\n");
+	for(size_t i = 0; b->size < size; i++) {
+		char head[96];
+		sprintf(head, "%s{\"id\": %zu, \"name\": \"", i ? ",\n" : "", i);
+		puts_buffer(b, head);
+		random_word(b, 8 + next_random() % 16);
+		puts_buffer(b, "\", \"active\": ");
+		puts_buffer(b, next_random() % 2 ? "true" : "false");
+		puts_buffer(b, ", \"score\": ");
+		random_number(b);
+		puts_buffer(b, ", \"location\": {\"lat\": ");
+		random_number(b);
+		puts_buffer(b, ", \"lng\": ");
+		random_number(b);
+		puts_buffer(b, "}, \"tags\": [\"");
+		random_word(b, 6);
+		puts_buffer(b, "\", \"");
+		random_word(b, 6);
+		puts_buffer(b, "\"], \"parent\": null}");
+	}
+	puts_buffer(b, "\n]}\n");
+}
+
+struct input {
+	const char *name;
+	struct buffer text;
+};
+
+static const struct {
+	const char *name;
+	void (*make)(struct buffer *b, size_t size);
+} generators[] = {
+	{"comments", make_comments},
+	{"numbers", make_numbers},
+	{"deep", make_deep},
+	{"strings", make_strings},
+	{"wide", make_wide},
+	{"records", make_records},
+};
+
+static int json_output, repeat = 5;
+
+/**
+ * 重复运行取最快的一次，分配统计取最后一次
+ */
+struct measure {
+	double seconds;
+	size_t allocations, allocated_bytes;
+	long peak_rss;
+};
+
+static double begin() {
+	allocations = allocated_bytes = 0;
+	return now();
+}
+
+static void end(struct measure *m, double start) {
+	double seconds = now() - start;
+	if(m->seconds == 0 || seconds < m->seconds)
+		m->seconds = seconds;
+	m->allocations = allocations;
+	m->allocated_bytes = allocated_bytes;
+}
+
+static void report(const char *input, const char *bench, size_t bytes, const struct measure *m) {
+	double mbs = bytes / 1e6 / m->seconds;
+	if(json_output) {
+		printf("{\"input\":\"%s\",\"bench\":\"%s\",\"bytes\":%zu,\"seconds\":%.6f,\"mb_s\":%.1f,"
+				"\"allocations\":%zu,\"allocated_bytes\":%zu,\"peak_rss_kb\":%ld}\n",
+				input, bench, bytes, m->seconds, mbs, m->allocations, m->allocated_bytes, m->peak_rss);
+	} else {
+		printf("%-12s %-22s %9.1f MB/s %9.4fs %10zu allocs %8.1f MB alloc %8ld KB peak\n",
+				input, bench, mbs, m->seconds, m->allocations, m->allocated_bytes / 1e6, m->peak_rss);
+	}
+	fflush(stdout);
+}
+
+static void release(cave_jsonc_document doc) {
+	cave_jsonc_release_all_nodes_in_document(doc);
+	cave_jsonc_release_document(doc);
+}
+
+/**
+ * 访问每个值，字符串读取长度，数字读取已经解码的double
+ */
+static double traverse(cave_jsonc_value value) {
+	double sum = 0;
+	switch(cave_jsonc_get_value_type(value)) {
+		case CAVE_JSONC_OBJECT:
+			for(cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(cave_jsonc_get_object(value)); pair;
+					pair = cave_jsonc_next_kvpair(pair))
+				sum += pair->key->length + traverse(pair->value);
+			break;
+		case CAVE_JSONC_ARRAY: {
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			for(size_t i = 0; i < array->length; i++)
+				sum += traverse(array->values[i]);
+			break;
+		}
+		case CAVE_JSONC_STRING:
+			sum += value->value.string->length;
+			break;
+		case CAVE_JSONC_NUMBER:
+			sum += cave_jsonc_get_double(value);
+			break;
+		default:
+			sum += 1;
+	}
+	return sum;
+}
+
+/**
+ * 文档中所有数字的原始文本
+ */
+struct number_texts {
+	const char **texts;
+	size_t count, cap, bytes;
+};
+
+static void collect_numbers(cave_jsonc_value value, struct number_texts *out) {
+	switch(cave_jsonc_get_value_type(value)) {
+		case CAVE_JSONC_OBJECT:
+			for(cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(cave_jsonc_get_object(value)); pair;
+					pair = cave_jsonc_next_kvpair(pair))
+				collect_numbers(pair->value, out);
+			break;
+		case CAVE_JSONC_ARRAY: {
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			for(size_t i = 0; i < array->length; i++)
+				collect_numbers(array->values[i], out);
+			break;
+		}
+		case CAVE_JSONC_NUMBER: {
+			cave_jsonc_string raw = cave_jsonc_get_raw_number(value);
+			if(out->count == out->cap) {
+				out->cap = out->cap ? out->cap * 2 : 1024;
+				out->texts = realloc(out->texts, out->cap * sizeof(const char *));
+			}
+			out->texts[out->count++] = raw->value;
+			out->bytes += raw->length;
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+/**
+ * stream为非0时走cave_jsonc_parse_document的逐字符接口
+ */
+static cave_jsonc_document parse(const struct buffer *text, int stream, int flags) {
+	if(!stream)
+		return cave_jsonc_parse_buffer(text->data, text->size, flags);
+	struct reader r = {text->data, text->data + text->size};
+	return cave_jsonc_parse_document_with_flags(reader_getc, &r, flags);
+}
+
+/**
+ * 准备被测的文档，失败时打印错误并返回NULL
+ */
+static cave_jsonc_document prepare(const struct buffer *text, int flags) {
+	cave_jsonc_document doc = parse(text, 0, flags);
+	if(!cave_jsonc_has_fatal_error(doc))
+		return doc;
+	cave_jsonc_print_error(doc, (int (*)(int, void *)) fputc, stderr);
+	release(doc);
+	return NULL;
+}
+
+/**
+ * 每项测试返回计算MB/s用的字节数，返回0表示没有结果
+ */
+static const int parse_flags[] = {
+	0,
+	0,
+	CAVE_JSONC_DOCUMENT_ARENA,
+	CAVE_JSONC_DOCUMENT_ARENA | CAVE_JSONC_DOCUMENT_BORROW,
+};
+
+static size_t bench_parse(const struct buffer *text, int variant, struct measure *m) {
+	for(int r = 0; r < repeat; r++) {
+		double start = begin();
+		cave_jsonc_document doc = parse(text, variant == 0, parse_flags[variant]);
+		end(m, start);
+		if(cave_jsonc_has_fatal_error(doc)) {
+			cave_jsonc_print_error(doc, (int (*)(int, void *)) fputc, stderr);
+			release(doc);
+			return 0;
+		}
+		release(doc);
+	}
+	return text->size;
+}
+
+/**
+ * variant的第0位表示最小化，第1位表示使用fputc回调
+ */
+static size_t bench_serialize(const struct buffer *text, int variant, struct measure *m) {
+	cave_jsonc_document doc = prepare(text, 0);
+	if(!doc)
+		return 0;
+	int mininize = variant & 1;
+	size_t length = 0;
+	struct buffer out = {0};
+	for(int r = 0; r < repeat; r++) {
+		out.size = 0;
+		double start = begin();
+		if(variant & 2) {
+			cave_jsonc_serialize_document(doc, buffer_putc, &out, mininize);
+			length = out.size;
+		} else {
+			free(cave_jsonc_serialize_document_to_memory(doc, mininize, &length));
+		}
+		end(m, start);
+	}
+	free(out.data);
+	release(doc);
+	return length;
+}
+
+static size_t bench_traverse(const struct buffer *text, int variant, struct measure *m) {
+	cave_jsonc_document doc = prepare(text, 0);
+	if(!doc)
+		return 0;
+	volatile double sink = 0;
+	for(int r = 0; r < repeat; r++) {
+		double start = begin();
+		sink += traverse(cave_jsonc_get_document_root(doc));
+		end(m, start);
+	}
+	release(doc);
+	return text->size;
+}
+
+/**
+ * 解析器总是立即解码数字，这里用输入中数字的原始文本创建只有文本的值，只对转换计时
+ * 转换结果会缓存在值中，每轮重新创建，MB/s按数字文本的字节数计算
+ */
+static size_t bench_numbers(const struct buffer *text, int variant, struct measure *m) {
+	cave_jsonc_document doc = prepare(text, CAVE_JSONC_DOCUMENT_RAW_NUMBER);
+	if(!doc)
+		return 0;
+	struct number_texts numbers = {0};
+	collect_numbers(cave_jsonc_get_document_root(doc), &numbers);
+	cave_jsonc_value *values = malloc((numbers.count + 1) * sizeof(cave_jsonc_value));
+	volatile double sink = 0;
+	for(int r = 0; r < repeat && numbers.count; r++) {
+		cave_jsonc_document values_doc = cave_jsonc_create_document_with_flags(CAVE_JSONC_DOCUMENT_ARENA);
+		for(size_t i = 0; i < numbers.count; i++)
+			values[i] = cave_jsonc_create_number_value(values_doc, numbers.texts[i], CAVE_JSONC_STRING_LIFECYCLE_NONE);
+		double start = begin();
+		for(size_t i = 0; i < numbers.count; i++)
+			sink += cave_jsonc_get_double(values[i]);
+		end(m, start);
+		cave_jsonc_release_document(values_doc);
+	}
+	free(values);
+	free(numbers.texts);
+	release(doc);
+	return numbers.bytes;
+}
+
+static const struct {
+	const char *name;
+	size_t (*run)(const struct buffer *text, int variant, struct measure *m);
+	int variant;
+} benches[] = {
+	{"parse_stream", bench_parse, 0},
+	{"parse_buffer", bench_parse, 1},
+	{"parse_arena", bench_parse, 2},
+	{"parse_borrow", bench_parse, 3},
+	{"serialize_min", bench_serialize, 1},
+	{"serialize_pretty", bench_serialize, 0},
+	{"serialize_fputc_min", bench_serialize, 3},
+	{"serialize_fputc_pretty", bench_serialize, 2},
+	{"numbers", bench_numbers, 0},
+	{"traverse", bench_traverse, 0},
+};
+
+static void run(const struct input *in) {
+	for(size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+		pid_t pid = fork();
+		if(pid == 0) {
+			struct measure m = {0};
+			size_t bytes = benches[i].run(&in->text, benches[i].variant, &m);
+			m.peak_rss = peak_rss();
+			if(bytes)
+				report(in->name, benches[i].name, bytes, &m);
+			_exit(0);
+		}
+		if(pid > 0)
+			waitpid(pid, NULL, 0);
+	}
+}
+
+static int read_file(const char *path, struct buffer *b) {
+	FILE *file = fopen(path, "rb");
+	if(!file)
+		return -1;
+	char chunk[65536];
+	size_t n;
+	while((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		put(b, chunk, n);
+	fclose(file);
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	size_t size = 8;
+	int i = 1;
+	for(; i < argc && argv[i][0] == '-'; i++) {
+		if(!strcmp(argv[i], "-j"))
+			json_output = 1;
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc)
+			size = strtoull(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-r") && i + 1 < argc)
+			repeat = atoi(argv[++i]);
+		else {
+			fprintf(stderr, "用法：%s [-s 每种输入的MB数] [-r 重复次数] [-j] [文件...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(repeat < 1)
+		repeat = 1;
+	for(size_t g = 0; g < sizeof(generators) / sizeof(generators[0]); g++) {
+		struct input in = {generators[g].name};
+		generators[g].make(&in.text, size * 1000000);
+		run(&in);
+		free(in.text.data);
+	}
+	for(; i < argc; i++) {
+		struct input in = {argv[i]};
+		if(read_file(argv[i], &in.text)) {
+			fprintf(stderr, "无法读取%s\n", argv[i]);
+			continue;
+		}
+		run(&in);
+		free(in.text.data);
+	}
+	return 0;
+}
@@ -2,21 +2,196 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * 在x86上使用SSE2/AVX2加速扫描，运行时根据CPU选择实现
+ * 定义CAVE_JSONC_NO_SIMD可以只保留标量实现
+ */
+#if !defined(CAVE_JSONC_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CAVE_JSONC_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/**
+ * 大文档的并行解析使用pthread，定义CAVE_JSONC_NO_THREADS时在调用线程中依次解析各段
+ */
+#ifndef CAVE_JSONC_NO_THREADS
+#include <pthread.h>
+#endif
+
+/**
+ * 定义CAVE_JSONC_STATS时解析器和序列化器把统计记录到cave_jsonc_stats，否则下面的宏不产生任何代码
+ * 未定义时只对数值参数取sizeof，既不求值也不会留下未使用的变量
+ * STAT_BEGIN和STAT_END之间的耗时计入一个阶段，其中嵌套的skip已经计入skip_ns，会被扣除
+ */
+#ifdef CAVE_JSONC_STATS
+#include <time.h>
+
+static uint64_t stat_clock(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+#define DOC_STATS(doc) ((doc) ? (doc)->stats : NULL)
+#define STAT_ADD(stats, field, n) do { if(stats) (stats)->field += (n); } while(0)
+#define STAT_MAX(stats, field, n) do { if((stats) && (stats)->field < (n)) (stats)->field = (n); } while(0)
+#define STAT_ALLOC(stats, size) do { if(stats) { (stats)->allocations++; (stats)->allocated_bytes += (size); } } while(0)
+#define STAT_BEGIN(stats) uint64_t stat_start = (stats) ? stat_clock() : 0, stat_skip = (stats) ? (stats)->skip_ns : 0
+#define STAT_END(stats, field) STAT_ADD(stats, field, stat_clock() - stat_start - ((stats)->skip_ns - stat_skip))
+#else
+#define STAT_ADD(stats, field, n) ((void) sizeof(n))
+#define STAT_MAX(stats, field, n) ((void) sizeof(n))
+#define STAT_ALLOC(stats, size) ((void) sizeof(size))
+#define STAT_BEGIN(stats) ((void) 0)
+#define STAT_END(stats, field) ((void) 0)
+#endif
+
+/**
+ * arena中的一块内存，块的大小从ARENA_MIN_CHUNK开始翻倍，直到ARENA_MAX_CHUNK
+ */
+struct _cave_jsonc_arena {
+	struct _cave_jsonc_arena *next;
+	size_t capacity, used;
+	_Alignas(16) char data[];
+};
+
+#define ARENA_ALIGN 16
+#define ARENA_MIN_CHUNK ((size_t) 16 << 10)
+#define ARENA_MAX_CHUNK ((size_t) 1 << 20)
+
+static struct _cave_jsonc_arena *arena_new_chunk(size_t capacity) {
+	struct _cave_jsonc_arena *chunk = malloc(sizeof(struct _cave_jsonc_arena) + capacity);
+	chunk->next = NULL;
+	chunk->capacity = capacity;
+	chunk->used = 0;
+	return chunk;
+}
+
+static void *arena_alloc(cave_jsonc_document doc, size_t size) {
+	size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+	struct _cave_jsonc_arena *chunk = doc->arena;
+	if(chunk && chunk->capacity - chunk->used >= size) {
+		void *rval = chunk->data + chunk->used;
+		chunk->used += size;
+		return rval;
+	}
+	size_t capacity = chunk ? chunk->capacity * 2 : ARENA_MIN_CHUNK;
+	if(capacity > ARENA_MAX_CHUNK)
+		capacity = ARENA_MAX_CHUNK;
+	if(size > capacity / 4) {
+		// 大块单独分配，挂在当前块之后，不打断当前块的顺序分配
+		struct _cave_jsonc_arena *big = arena_new_chunk(size);
+		STAT_ALLOC(doc->stats, sizeof(struct _cave_jsonc_arena) + size);
+		big->used = size;
+		if(chunk) {
+			big->next = chunk->next;
+			chunk->next = big;
+		} else
+			doc->arena = big;
+		return big->data;
+	}
+	chunk = arena_new_chunk(capacity);
+	STAT_ALLOC(doc->stats, sizeof(struct _cave_jsonc_arena) + capacity);
+	chunk->next = doc->arena;
+	doc->arena = chunk;
+	chunk->used = size;
+	return chunk->data;
+}
+
+static void arena_release(cave_jsonc_document doc) {
+	struct _cave_jsonc_arena *chunk = doc->arena;
+	while(chunk) {
+		struct _cave_jsonc_arena *next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	doc->arena = NULL;
+}
+
+static int is_arena(cave_jsonc_document doc) {
+	return doc && (doc->flags & CAVE_JSONC_DOCUMENT_ARENA);
+}
+
+/**
+ * 为文档中的节点分配内存，arena模式下从arena中分配
+ */
+static void *doc_alloc(cave_jsonc_document doc, size_t size) {
+	if(is_arena(doc))
+		return arena_alloc(doc, size);
+	STAT_ALLOC(DOC_STATS(doc), size);
+	return malloc(size);
+}
+
+static void doc_free(cave_jsonc_document doc, void *ptr) {
+	if(!is_arena(doc))
+		free(ptr);
+}
 
 cave_jsonc_document cave_jsonc_create_document(void) {
+	return cave_jsonc_create_document_with_flags(0);
+}
+
+cave_jsonc_document cave_jsonc_create_document_with_flags(int flags) {
 	cave_jsonc_document doc = malloc(sizeof(struct _cave_jsonc_document));
 	doc->all_allocated = doc->root = NULL;
 	doc->error_tail = doc->error_head = NULL;
 	doc->fatal = 0;
+	doc->flags = flags;
+	doc->arena = NULL;
+	doc->mapping = NULL;
+	doc->mapping_length = 0;
+	doc->source = NULL;
+	doc->source_length = 0;
+	doc->intern = NULL;
+	doc->stats = NULL;
 	return doc;
 }
 
 void cave_jsonc_release_all_nodes_in_document(cave_jsonc_document doc) {
+	if(is_arena(doc)) {
+		arena_release(doc);
+		doc->root = NULL;
+		return;
+	}
 	while(doc->all_allocated)
 		cave_jsonc_release_value(doc->all_allocated);
 }
 
+/**
+ * 延迟解析的容器还没有解析时object和array为NULL
+ */
+static int is_lazy(cave_jsonc_value value) {
+	return (value->type == CAVE_JSONC_OBJECT || value->type == CAVE_JSONC_ARRAY) && !value->value.lazy.container;
+}
+
+static void materialize(cave_jsonc_value value);
+static void keep_interned(cave_jsonc_value value, cave_jsonc_document target);
+
 void cave_jsonc_transform_node_document(cave_jsonc_value value, cave_jsonc_document target) {
+	// 延迟解析的容器离开文档后无法再找到源文本
+	if(value->document && target && value->document != target && is_lazy(value))
+		materialize(value);
+	if(is_arena(value->document) || is_arena(target)) {
+		// arena中的值的内存属于分配它的文档，只能在这个文档上挂上或摘下
+		if(value->document && target && value->document != target)
+			abort();
+		value->prev = value->next = NULL;
+		if(target)
+			value->document = target;
+		return;
+	}
+	if(value->document && target && value->document != target)
+		keep_interned(value, target);
 	if(value->document){
 		if(value->document->all_allocated == value)
 			value->document->all_allocated = value->next;
@@ -42,6 +217,10 @@ void cave_jsonc_release_document(cave_jsonc_document doc) {
 		free(err);
 		err = next;
 	}
+	arena_release(doc);
+	if(doc->mapping)
+		munmap(doc->mapping, doc->mapping_length);
+	cave_jsonc_release_intern(doc->intern);
 	free(doc);
 }
 
@@ -54,7 +233,7 @@ void cave_jsonc_set_document_root(cave_jsonc_document doc, cave_jsonc_value root
 }
 
 static cave_jsonc_value alloc_value(cave_jsonc_document doc, cave_jsonc_type type) {
-	cave_jsonc_value value = malloc(sizeof(struct _cave_jsonc_value));
+	cave_jsonc_value value = doc_alloc(doc, sizeof(struct _cave_jsonc_value));
 	value->document = NULL;
 	cave_jsonc_transform_node_document(value, doc);
 	value->type = type;
@@ -72,14 +251,29 @@ cave_jsonc_value cave_jsonc_create_boolean_value(cave_jsonc_document doc, int va
 	return rval;
 }
 
-cave_jsonc_string alloc_string(const char *r, size_t length, int lifecycle) {
-	if(lifecycle & CAVE_JSONC_STRING_LIFECYCLE_ALLOC) {
+/**
+ * 驻留表中的字符串，由驻留表统一释放，文档释放字符串时跳过
+ */
+#define STRING_INTERNED 8
+
+static cave_jsonc_string alloc_string(cave_jsonc_document doc, const char *r, size_t length, int lifecycle) {
+	if(is_arena(doc) && lifecycle != CAVE_JSONC_STRING_LIFECYCLE_NONE) {
+		// arena模式下复制进arena，交给jsonc释放的原缓冲区立即释放
+		char *target = arena_alloc(doc, length + 1);
+		memcpy(target, r, length);
+		target[length] = 0;
+		if(lifecycle == CAVE_JSONC_STRING_LIFECYCLE_FREE)
+			free((char *) r);
+		r = target;
+		lifecycle = CAVE_JSONC_STRING_LIFECYCLE_NONE;
+	} else if(lifecycle & CAVE_JSONC_STRING_LIFECYCLE_ALLOC) {
+		STAT_ALLOC(DOC_STATS(doc), length + 1);
 		char *target = malloc(length + 1);
 		memcpy(target, r, length);
 		target[length] = 0;
 		r = target;
 	}
-	cave_jsonc_string rval = malloc(sizeof(struct _cave_jsonc_string));
+	cave_jsonc_string rval = doc_alloc(doc, sizeof(struct _cave_jsonc_string));
 	rval->value = (char *)r;
 	rval->free = lifecycle & CAVE_JSONC_STRING_LIFECYCLE_FREE;
 	rval->length = length;
@@ -87,44 +281,40 @@ cave_jsonc_string alloc_string(const char *r, size_t length, int lifecycle) {
 }
 
 cave_jsonc_value cave_jsonc_create_number_value(cave_jsonc_document doc, const char *r, int lifecycle) {
-	cave_jsonc_number num = malloc(sizeof(struct _cave_jsonc_number));
-	num->flag = CAVE_JSONC_NUM_RAW;
-	num->raw = alloc_string(r, strlen(r), lifecycle);
 	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_NUMBER);
-	rval->value.number = num;
+	rval->value.number.flag = CAVE_JSONC_NUM_RAW;
+	rval->value.number.raw = alloc_string(doc, r, strlen(r), lifecycle);
 	return rval;
 }
 
 cave_jsonc_value cave_jsonc_create_integer_value(cave_jsonc_document doc, long long i) {
-	cave_jsonc_number num = malloc(sizeof(struct _cave_jsonc_number));
-	num->flag = CAVE_JSONC_NUM_IVAL;
-	num->ival = i;
 	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_NUMBER);
-	rval->value.number = num;
+	rval->value.number.flag = CAVE_JSONC_NUM_IVAL;
+	rval->value.number.ival = i;
 	return rval;
 }
 
 cave_jsonc_value cave_jsonc_create_double_value(cave_jsonc_document doc, double f)  {
-	cave_jsonc_number num = malloc(sizeof(struct _cave_jsonc_number));
-	num->flag = CAVE_JSONC_NUM_FVAL;
-	num->fval = f;
 	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_NUMBER);
-	rval->value.number = num;
+	rval->value.number.flag = CAVE_JSONC_NUM_FVAL;
+	rval->value.number.fval = f;
 	return rval;
 }
 cave_jsonc_value cave_jsonc_create_null_termined_string_value(cave_jsonc_document doc, const char *s, int lifecycle) {
-	return cave_jsonc_create_string_value(doc, s, sizeof(s), lifecycle);
+	return cave_jsonc_create_string_value(doc, s, strlen(s), lifecycle);
 }
 
 cave_jsonc_value cave_jsonc_create_string_value(cave_jsonc_document doc, const char *s, size_t length, int lifecycle) {
 	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_STRING);
-	rval->value.string = alloc_string(s, length, lifecycle);
+	rval->value.string = alloc_string(doc, s, length, lifecycle);
 	return rval;
 }
 
 cave_jsonc_value cave_jsonc_create_object_value(cave_jsonc_document doc) {
-	cave_jsonc_object object = malloc(sizeof(struct _cave_jsonc_object));
+	cave_jsonc_object object = doc_alloc(doc, sizeof(struct _cave_jsonc_object));
 	object->head = object->tail = NULL;
+	object->length = 0;
+	object->index = NULL;
 	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_OBJECT);
 	rval->value.object = object;
 	object->value = rval;
@@ -132,47 +322,54 @@ cave_jsonc_value cave_jsonc_create_object_value(cave_jsonc_document doc) {
 }
 
 cave_jsonc_value cave_jsonc_create_array_value(cave_jsonc_document doc, size_t length) {
-	cave_jsonc_array array = malloc(sizeof(struct _cave_jsonc_array));
+	cave_jsonc_array array = doc_alloc(doc, sizeof(struct _cave_jsonc_array));
 	array->length = length;
-	array->values = malloc(sizeof(cave_jsonc_value) * length);
-	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_OBJECT);
+	array->values = doc_alloc(doc, sizeof(cave_jsonc_value) * length);
+	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_ARRAY);
 	rval->value.array = array;
 	return rval;
 }
 
-void release_string(cave_jsonc_string string) {
+static void release_string(cave_jsonc_document doc, cave_jsonc_string string) {
+	if(string->free & STRING_INTERNED)
+		return;
 	if(string->free & CAVE_JSONC_STRING_LIFECYCLE_FREE)
 		free(string->value);
-	free(string);
+	doc_free(doc, string);
 }
 
 void cave_jsonc_release_value(cave_jsonc_value value) {
+	cave_jsonc_document doc = value->document;
 	switch (value->type) {
 		case CAVE_JSONC_NULL:
 		case CAVE_JSONC_BOOLEAN:
 			break;
 		case CAVE_JSONC_NUMBER:
-			if(value->value.number->flag & CAVE_JSONC_NUM_RAW)
-				release_string(value->value.number->raw);
-			free(value->value.number);
+			if(value->value.number.flag & CAVE_JSONC_NUM_RAW)
+				release_string(doc, value->value.number.raw);
 			break;
 		case CAVE_JSONC_STRING:
-			release_string(value->value.string);
+			release_string(doc, value->value.string);
 			break;
 		case CAVE_JSONC_OBJECT:
+			if(is_lazy(value))
+				break;
 			while(value->value.object->head)
 				cave_jsonc_release_kvpair(cave_jsonc_take_kvpair_from_object(value->value.object->head));
-			free(value->value.object);
+			doc_free(doc, value->value.object->index);
+			doc_free(doc, value->value.object);
 			break;
 		case CAVE_JSONC_ARRAY:
-			free(value->value.array->values);
-			free(value->value.array);
+			if(is_lazy(value))
+				break;
+			doc_free(doc, value->value.array->values);
+			doc_free(doc, value->value.array);
 			break;
 		case CAVE_JSONC_UNDEFINED:
 			abort(); // IMPOSSIBLE
 	}
 	cave_jsonc_transform_node_document(value, NULL);
-	free(value);
+	doc_free(doc, value);
 }
 
 cave_jsonc_type cave_jsonc_get_value_type(cave_jsonc_value value) {
@@ -192,9 +389,10 @@ cave_jsonc_kvpair cave_jsonc_create_kvpair_with_null_termined_key(cave_jsonc_obj
 }
 
 cave_jsonc_kvpair cave_jsonc_create_kvpair(cave_jsonc_object obj, const char *k, size_t klength, int lifecycle) {
-	cave_jsonc_kvpair rval = malloc(sizeof(struct _cave_jsonc_kvpair));
+	cave_jsonc_document doc = obj->value->document;
+	cave_jsonc_kvpair rval = doc_alloc(doc, sizeof(struct _cave_jsonc_kvpair));
 	rval->object = NULL;
-	rval->key = alloc_string(k, klength, lifecycle);
+	rval->key = alloc_string(doc, k, klength, lifecycle);
 	rval->value = NULL;
 	rval->position = (cave_jsonc_position) {-1, -1, -1};
 	cave_jsonc_move_kvpair_to_object(rval, obj);
@@ -213,14 +411,24 @@ void cave_jsonc_set_null_termined_key(cave_jsonc_kvpair pair, const char *s, int
 	cave_jsonc_set_key(pair, s, strlen(s), lifecycle);
 }
 
+static cave_jsonc_document kvpair_document(cave_jsonc_kvpair pair) {
+	return pair->object ? pair->object->value->document : NULL;
+}
+
+static void drop_index(cave_jsonc_object object);
+
 void cave_jsonc_set_key(cave_jsonc_kvpair pair, const char *s, size_t length, int lifecycle) {
-	release_string(pair->key);
-	pair->key = alloc_string(s, length, lifecycle);
+	cave_jsonc_document doc = kvpair_document(pair);
+	if(pair->object)
+		drop_index(pair->object);
+	release_string(doc, pair->key);
+	pair->key = alloc_string(doc, s, length, lifecycle);
 }
 
 void cave_jsonc_release_kvpair(cave_jsonc_kvpair pair) {
-	release_string(pair->key);
-	free(pair);
+	cave_jsonc_document doc = kvpair_document(pair);
+	release_string(doc, pair->key);
+	doc_free(doc, pair);
 }
 
 void cave_jsonc_set_key_position(cave_jsonc_kvpair value, cave_jsonc_position pos) {
@@ -231,6 +439,234 @@ cave_jsonc_position cave_jsonc_get_key_position(cave_jsonc_kvpair value) {
 	return value->position;
 }
 
+/**
+ * 对象的键索引，线性探测的开放寻址哈希表
+ * 同名的键只索引第一个，出现过同名键时删除被索引的键值对会使索引失效，下次查找时重建
+ */
+struct _cave_jsonc_object_index {
+	size_t capacity, count;
+	int duplicated;
+	struct {
+		size_t hash;
+		cave_jsonc_kvpair pair;
+	} slots[];
+};
+
+/**
+ * 键值对少于这个数时直接遍历链表查找，不建立索引
+ */
+#define INDEX_THRESHOLD 8
+
+static size_t hash_key(const char *key, size_t length) {
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for(size_t i = 0; i < length; i++) {
+		hash ^= (unsigned char) key[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+static inline int key_equals(cave_jsonc_string key, const char *s, size_t length) {
+	return key->length == length && (key->value == s || !memcmp(key->value, s, length));
+}
+
+/**
+ * 驻留的字符串，哈希值和字符紧跟在字符串之前和之后
+ */
+struct interned_string {
+	size_t hash;
+	struct _cave_jsonc_string string;
+	char text[];
+};
+
+/**
+ * 驻留表，线性探测的开放寻址哈希表，按引用计数释放
+ */
+struct _cave_jsonc_intern {
+	size_t capacity, count, references;
+	struct interned_string **slots;
+};
+
+/**
+ * 值字符串不超过这个长度时驻留，键总是驻留
+ */
+#define INTERN_MAX_VALUE 32
+
+cave_jsonc_intern cave_jsonc_create_intern(void) {
+	cave_jsonc_intern intern = malloc(sizeof(struct _cave_jsonc_intern));
+	intern->capacity = 64;
+	intern->count = 0;
+	intern->references = 1;
+	intern->slots = calloc(intern->capacity, sizeof(struct interned_string *));
+	return intern;
+}
+
+void cave_jsonc_release_intern(cave_jsonc_intern intern) {
+	if(!intern || --intern->references)
+		return;
+	for(size_t i = 0; i < intern->capacity; i++)
+		free(intern->slots[i]);
+	free(intern->slots);
+	free(intern);
+}
+
+/**
+ * 返回与给定内容相同的驻留字符串，不存在时加入驻留表
+ */
+static cave_jsonc_string intern_string(cave_jsonc_intern intern, const char *s, size_t length) {
+	size_t hash = hash_key(s, length), mask = intern->capacity - 1, i = hash & mask;
+	for(; intern->slots[i]; i = (i + 1) & mask) {
+		struct interned_string *entry = intern->slots[i];
+		if(entry->hash == hash && key_equals(&entry->string, s, length))
+			return &entry->string;
+	}
+	struct interned_string *entry = malloc(sizeof(struct interned_string) + length + 1);
+	entry->hash = hash;
+	memcpy(entry->text, s, length);
+	entry->text[length] = 0;
+	entry->string.value = entry->text;
+	entry->string.length = length;
+	entry->string.free = STRING_INTERNED;
+	intern->slots[i] = entry;
+	if(++intern->count * 2 > intern->capacity) {
+		// 表过半时翻倍重新插入
+		struct interned_string **slots = intern->slots;
+		size_t capacity = intern->capacity;
+		intern->capacity *= 2;
+		intern->slots = calloc(intern->capacity, sizeof(struct interned_string *));
+		mask = intern->capacity - 1;
+		for(size_t j = 0; j < capacity; j++)
+			if(slots[j]) {
+				for(i = slots[j]->hash & mask; intern->slots[i]; i = (i + 1) & mask)
+					;
+				intern->slots[i] = slots[j];
+			}
+		free(slots);
+	}
+	return &entry->string;
+}
+
+/**
+ * 驻留的字符串直接使用保存的哈希值
+ */
+static size_t string_hash(cave_jsonc_string string) {
+	if(string->free & STRING_INTERNED)
+		return ((struct interned_string *) ((char *) string - offsetof(struct interned_string, string)))->hash;
+	return hash_key(string->value, string->length);
+}
+
+/**
+ * 值离开原来的文档后驻留的字符串仍然要有效
+ * 目标文档没有驻留表时持有原来的表的引用，否则复制这个值直接引用的驻留字符串
+ */
+static void keep_interned(cave_jsonc_value value, cave_jsonc_document target) {
+	cave_jsonc_intern intern = value->document->intern;
+	if(!intern || target->intern == intern)
+		return;
+	if(!target->intern) {
+		intern->references++;
+		target->intern = intern;
+	} else if(value->type == CAVE_JSONC_STRING) {
+		cave_jsonc_string string = value->value.string;
+		if(string->free & STRING_INTERNED)
+			value->value.string = alloc_string(target, string->value, string->length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	} else if(value->type == CAVE_JSONC_OBJECT) {
+		for(cave_jsonc_kvpair pair = value->value.object->head; pair; pair = pair->next)
+			if(pair->key->free & STRING_INTERNED)
+				pair->key = alloc_string(target, pair->key->value, pair->key->length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	}
+}
+
+static cave_jsonc_document object_document(cave_jsonc_object object) {
+	return object->value ? object->value->document : NULL;
+}
+
+static void drop_index(cave_jsonc_object object) {
+	doc_free(object_document(object), object->index);
+	object->index = NULL;
+}
+
+/**
+ * 返回键所在的槽，不存在时返回应当插入的空槽
+ */
+static size_t index_probe(struct _cave_jsonc_object_index *index, const char *key, size_t length, size_t hash) {
+	size_t mask = index->capacity - 1, i = hash & mask;
+	while(index->slots[i].pair && (index->slots[i].hash != hash || !key_equals(index->slots[i].pair->key, key, length)))
+		i = (i + 1) & mask;
+	return i;
+}
+
+/**
+ * 把键值对放进索引，first为真时覆盖同名的键
+ */
+static void index_put(struct _cave_jsonc_object_index *index, cave_jsonc_kvpair pair, int first) {
+	size_t hash = string_hash(pair->key);
+	size_t i = index_probe(index, pair->key->value, pair->key->length, hash);
+	if(index->slots[i].pair) {
+		index->duplicated = 1;
+		if(!first)
+			return;
+	} else
+		index->count++;
+	index->slots[i].hash = hash;
+	index->slots[i].pair = pair;
+}
+
+static void build_index(cave_jsonc_object object) {
+	size_t capacity = 16;
+	while(capacity < object->length * 2)
+		capacity *= 2;
+	struct _cave_jsonc_object_index *index = doc_alloc(object_document(object),
+			sizeof(struct _cave_jsonc_object_index) + capacity * sizeof(index->slots[0]));
+	index->capacity = capacity;
+	index->count = 0;
+	index->duplicated = 0;
+	memset(index->slots, 0, capacity * sizeof(index->slots[0]));
+	for(cave_jsonc_kvpair pair = object->head; pair; pair = pair->next)
+		index_put(index, pair, 0);
+	object->index = index;
+}
+
+/**
+ * 对象插入键值对后维护索引，索引太满时丢弃，下次查找时按新的大小重建
+ */
+static void index_inserted(cave_jsonc_object object, cave_jsonc_kvpair pair, int first) {
+	object->length++;
+	if(!object->index)
+		return;
+	if((object->index->count + 1) * 2 > object->index->capacity)
+		drop_index(object);
+	else
+		index_put(object->index, pair, first);
+}
+
+/**
+ * 线性探测表的删除：把后面探测链上的元素前移填补空位
+ */
+static void index_taken(cave_jsonc_object object, cave_jsonc_kvpair pair) {
+	object->length--;
+	struct _cave_jsonc_object_index *index = object->index;
+	if(!index)
+		return;
+	size_t mask = index->capacity - 1;
+	size_t i = index_probe(index, pair->key->value, pair->key->length, string_hash(pair->key));
+	if(index->slots[i].pair != pair)
+		return;
+	if(index->duplicated) {
+		drop_index(object);
+		return;
+	}
+	index->count--;
+	for(size_t j = (i + 1) & mask; index->slots[j].pair; j = (j + 1) & mask) {
+		size_t home = index->slots[j].hash & mask;
+		if(((j - home) & mask) >= ((j - i) & mask)) {
+			index->slots[i] = index->slots[j];
+			i = j;
+		}
+	}
+	index->slots[i].pair = NULL;
+}
+
 cave_jsonc_kvpair cave_jsonc_get_first_kvpair(cave_jsonc_object object) {
 	return object->head;
 }
@@ -247,6 +683,7 @@ cave_jsonc_kvpair cave_jsonc_insert_first_kvpair(cave_jsonc_object object, cave_
 	else
 		object->tail = pair;
 	object->head = pair;
+	index_inserted(object, pair, 1);
 	return pair;
 }
 
@@ -258,6 +695,7 @@ cave_jsonc_kvpair cave_jsonc_insert_last_kvpair(cave_jsonc_object object, cave_j
 	else
 		object->head = pair;
 	object->tail = pair;
+	index_inserted(object, pair, 0);
 	return pair;
 }
 
@@ -278,753 +716,6717 @@ cave_jsonc_kvpair cave_jsonc_take_kvpair_from_object(cave_jsonc_kvpair pair) {
 		pair->prev->next = pair->next;
 	else
 		pair->object->head = pair->next;
+	index_taken(pair->object, pair);
 	return pair;
 }
 
+/**
+ * 按键查找，hash为0时在需要时计算，路径查询传入预先算好的hash
+ */
+static cave_jsonc_kvpair find_kvpair(cave_jsonc_object object, const char *key, size_t length, size_t hash) {
+	if(!object->index) {
+		if(object->length < INDEX_THRESHOLD) {
+			for(cave_jsonc_kvpair pair = object->head; pair; pair = pair->next)
+				if(key_equals(pair->key, key, length))
+					return pair;
+			return NULL;
+		}
+		build_index(object);
+	}
+	return object->index->slots[index_probe(object->index, key, length, hash ? hash : hash_key(key, length))].pair;
+}
+
+cave_jsonc_kvpair cave_jsonc_object_get_kvpair(cave_jsonc_object object, const char *key, size_t length) {
+	return find_kvpair(object, key, length, 0);
+}
+
+cave_jsonc_value cave_jsonc_object_get(cave_jsonc_object object, const char *key, size_t length) {
+	cave_jsonc_kvpair pair = cave_jsonc_object_get_kvpair(object, key, length);
+	return pair ? pair->value : NULL;
+}
+
+cave_jsonc_value cave_jsonc_object_remove(cave_jsonc_object object, const char *key, size_t length) {
+	cave_jsonc_kvpair pair = cave_jsonc_object_get_kvpair(object, key, length);
+	if(!pair)
+		return NULL;
+	cave_jsonc_value value = pair->value;
+	cave_jsonc_release_kvpair(cave_jsonc_take_kvpair_from_object(pair));
+	return value;
+}
+
 cave_jsonc_array cave_jsonc_get_array(cave_jsonc_value value) {
+	if(is_lazy(value))
+		materialize(value);
 	return value->value.array;
 }
 
 cave_jsonc_object cave_jsonc_get_object(cave_jsonc_value value) {
+	if(is_lazy(value))
+		materialize(value);
 	return value->value.object;
 }
 
-static _Thread_local int in;
-static _Thread_local int (*ffgetc)(void *file);
-static _Thread_local void *ffile;
-static _Thread_local cave_jsonc_document gdoc;
-static _Thread_local cave_jsonc_position pos;
-static int next() {
-	if(in == '\n') {
-		pos.cols = 1;
-		pos.row++;
-	}
-	pos.index++;
-	pos.cols++;
-	return in = ffgetc(ffile);
-}
-
-static void skip() {
-	while(in == ' ' || in == '\r' || in == '\n' || in == '\t' || in == '\b') {
-		if(next() == '/') {
-			cave_jsonc_position p = pos;
-			int prev = in;
-			if(next() == '/') {
-				while(next() != '\n' && in >= 0);
-			} else if(in == '*') {
-				while((next() != '/' || prev != '*') && in >= 0)
-					prev = in;
-				next();
-			} else {
-				cave_jsonc_report_error(gdoc, "无意义内容", p, 1);
-				break;
+/**
+ * JSON Pointer的一段，键已经去掉转义并算好哈希
+ * 是合法的数组下标时index为下标，否则为SIZE_MAX，wildcard表示匹配所有成员的*
+ */
+struct path_segment {
+	const char *key;
+	size_t length, hash, index;
+	int wildcard;
+};
+
+struct _cave_jsonc_path {
+	size_t count;
+	struct path_segment *segments;
+};
+
+/**
+ * 多条路径合并成的前缀树，节点0是根，子节点用first_child和next_sibling串起来
+ * 在节点上结束的路径用paths和path_next串起来
+ */
+struct path_node {
+	struct path_segment *segment;
+	size_t first_child, next_sibling, paths;
+};
+
+struct _cave_jsonc_path_set {
+	cave_jsonc_path *paths;
+	size_t count;
+	struct path_node *nodes;
+	size_t node_count;
+	size_t *path_next;
+};
+
+/**
+ * 编译RFC 6901的JSON Pointer，空串表示根，否则每段以/开头，~0表示~，~1表示/
+ * 有CAVE_JSONC_PATH_WILDCARD时整段为*匹配对象或数组的所有成员，~2表示字面的*，否则*只是普通字符
+ * 格式错误时返回NULL
+ */
+cave_jsonc_path cave_jsonc_compile_path_with_options(const char *pointer, size_t length, int options) {
+	int wildcard = options & CAVE_JSONC_PATH_WILDCARD;
+	if(length && pointer[0] != '/')
+		return NULL;
+	size_t count = 0;
+	for(size_t i = 0; i < length; i++)
+		count += pointer[i] == '/';
+	// 段、解码后的键放在同一块内存中，解码不会变长
+	cave_jsonc_path path = malloc(sizeof(struct _cave_jsonc_path) + sizeof(struct path_segment) * count + length);
+	path->count = count;
+	path->segments = (struct path_segment *) (path + 1);
+	char *keys = (char *) (path->segments + count), *out = keys;
+	const char *p = pointer, *end = pointer + length;
+	for(size_t i = 0; i < count; i++) {
+		struct path_segment *segment = &path->segments[i];
+		const char *start = ++p;
+		segment->key = out;
+		segment->wildcard = 0;
+		for(; p < end && *p != '/'; p++) {
+			if(*p != '~') {
+				*out++ = *p;
+				continue;
+			}
+			if(++p == end || *p < '0' || *p > (wildcard ? '2' : '1')) {
+				free(path);
+				return NULL;
+			}
+			*out++ = *p == '0' ? '~' : *p == '1' ? '/' : '*';
+		}
+		segment->length = out - segment->key;
+		segment->wildcard = wildcard && p - start == 1 && *start == '*';
+		segment->hash = hash_key(segment->key, segment->length);
+		// 数组下标不能有多余的前导0，“-”表示数组末尾之后，不会匹配任何元素
+		segment->index = SIZE_MAX;
+		if(segment->length && (segment->key[0] != '0' || segment->length == 1)) {
+			size_t index = 0, j = 0;
+			for(; j < segment->length && segment->key[j] >= '0' && segment->key[j] <= '9'; j++) {
+				if(index > (SIZE_MAX - 10) / 10)
+					break;
+				index = index * 10 + (segment->key[j] - '0');
 			}
+			if(j == segment->length)
+				segment->index = index;
 		}
 	}
+	return path;
 }
 
-static _Thread_local char *buf;
-static _Thread_local size_t cap = 256, size = 0;
-static void put_buf(char c) {
-	buf[size++] = c;
-	if(size == cap) {
-		cap *= 2;
-		buf = realloc(buf, cap);
-	}
+cave_jsonc_path cave_jsonc_compile_path(const char *pointer, size_t length) {
+	return cave_jsonc_compile_path_with_options(pointer, length, 0);
 }
 
-static cave_jsonc_value parse_number() {
-	cave_jsonc_position p = pos;
-	buf = malloc(256);
-	cap = 256;
-	size = 1;
-	buf[0] = in;
-	while(next() >= '0' && in <= '9') 
-		put_buf(in);
-	if(in == '.') {
-		if(buf[size - 1] == '-') {
-			cave_jsonc_report_error(gdoc, "小数点前必须要有整数部分", pos, 1);
-			free(buf);
-			return NULL;
-		}
-		put_buf('.');
-		while(next() >= '0' && in <= '9') 
-			put_buf(in);
-	}
-	if(in == 'e' || in == 'E') {
-		if(buf[size - 1] == '.') {
-			cave_jsonc_report_error(gdoc, "科学计数法小数点后必须要有小数部分", pos, 1);
-			free(buf);
-			return NULL;
-		} else if(buf[size - 1] == '-') {
-			cave_jsonc_report_error(gdoc, "科学计数法必须要有有效数位", pos, 1);
-			free(buf);
-			return NULL;
-		}
-		put_buf(in);
-		if(next() == '-' || (in >= '0' && in <= '9'))
-			put_buf(in);
-		while(next() >= '0' && in <= '9') 
-			put_buf(in);
+void cave_jsonc_release_path(cave_jsonc_path path) {
+	free(path);
+}
+
+/**
+ * 沿不是通配符的一段前进一步，不存在时返回NULL
+ */
+static cave_jsonc_value path_step(const struct path_segment *segment, cave_jsonc_value value) {
+	if(value->type == CAVE_JSONC_OBJECT) {
+		cave_jsonc_kvpair pair = find_kvpair(cave_jsonc_get_object(value), segment->key, segment->length, segment->hash);
+		return pair ? pair->value : NULL;
+	} else if(value->type == CAVE_JSONC_ARRAY) {
+		cave_jsonc_array array = cave_jsonc_get_array(value);
+		return segment->index < array->length ? array->values[segment->index] : NULL;
 	}
-	if(buf[size - 1] == '.') {
-		cave_jsonc_report_error(gdoc, "小数点后必须要有小数部分", pos, 1);
-		free(buf);
-		return NULL;
-	} else if(buf[size - 1] == '-') {
-		cave_jsonc_report_error(gdoc, "无意义的负号", pos, 1);
-		free(buf);
-		return NULL;
-	} else if(buf[size - 1] == 'e' || buf[size - 1] == 'E') {
-		cave_jsonc_report_error(gdoc, "科学计数法必须要有指数位", pos, 1);
-		free(buf);
-		return NULL;
-	} else if((size >= 2 && buf[0] == '0' && buf[1] >= '0' && buf[1] <= '9') ||
-			(size >= 3 && buf[0] == '-' && buf[1] == '0' && buf[2] >= '0' && buf[2] <= '9')) {
-		cave_jsonc_report_error(gdoc, "数字不得有前导0", p, 1);
-		free(buf);
-		return NULL;
+	return NULL;
+}
+
+/**
+ * 从第i段开始匹配，每找到一个值调用一次found，found返回非0时停止并返回非0
+ */
+static int path_walk(cave_jsonc_path path, size_t i, cave_jsonc_value value,
+		int (*found)(void *user, cave_jsonc_value value), void *user) {
+	for(; value && i < path->count && !path->segments[i].wildcard; i++)
+		value = path_step(&path->segments[i], value);
+	if(!value)
+		return 0;
+	if(i == path->count)
+		return found(user, value);
+	if(value->type == CAVE_JSONC_OBJECT) {
+		for(cave_jsonc_kvpair pair = cave_jsonc_get_object(value)->head; pair; pair = pair->next)
+			if(path_walk(path, i + 1, pair->value, found, user))
+				return 1;
+	} else if(value->type == CAVE_JSONC_ARRAY) {
+		cave_jsonc_array array = cave_jsonc_get_array(value);
+		for(size_t j = 0; j < array->length; j++)
+			if(path_walk(path, i + 1, array->values[j], found, user))
+				return 1;
 	}
-	skip();
-	put_buf('\0');
-	return cave_jsonc_create_number_value(gdoc, buf, CAVE_JSONC_STRING_LIFECYCLE_FREE);
+	return 0;
 }
 
-static int get_utf16() {
-	int ucs = 0;
-	for(int i = 0; i < 4; i++)
-		if(next() < 0) {
-			cave_jsonc_report_error(gdoc, "UTF-16转义字符解析到达文件末尾", pos, 1);
-			free(buf);
-			return -1;
-		} else if(in >= '0' && in <='9') {
-			ucs = (ucs << 4) + (in - '0');
-		} else if (in >= 'a' && in <= 'f') {
-			ucs = (ucs << 4) + (in - 'a' + 10);
-		} else if (in >= 'A' && in <= 'F') {
-			ucs = (ucs << 4) + (in - 'A' + 10);
-		} else {
-			cave_jsonc_report_error(gdoc, "UTF-16转义字符必须以四位十六进制数表示", pos, 1);
-			free(buf);
-			return -1;
-		}
-	return ucs;
+struct path_results {
+	cave_jsonc_value *results;
+	size_t size, capacity;
+};
+
+static int collect_result(void *user, cave_jsonc_value value) {
+	struct path_results *r = user;
+	if(r->size < r->capacity)
+		r->results[r->size] = value;
+	r->size++;
+	return 0;
 }
 
-static cave_jsonc_string get_string() {
-	buf = malloc(256);
-	cap = 256;
-	size = 0;
-	next();// 跳过引号
-	do {
-		if(in < 0) {
-			cave_jsonc_report_error(gdoc, "引号在文件末尾仍未配对", pos, 1);
-			free(buf);
-			return NULL;
-		} else if(in == '\n') {
-			cave_jsonc_report_error(gdoc, "不能跨行书写字符串", pos, 1);
-			free(buf);
-			return NULL;
-		}
-		if(in == '\\') {
-			if(next() == '\\') {
-				put_buf('\\');
-			} else if(in == 'n') {
-				put_buf('\n');
-			} else if(in == 'r') {
-				put_buf('\r');
-			} else if(in == 't') {
-				put_buf('\t');
-			} else if(in == 'b') {
-				put_buf('\b');
-			} else if(in == 'f') {
-				put_buf('\f');
-			} else if(in == '/') {
-				put_buf('/');
-			} else if(in == '\'') {
-				put_buf('\'');
-			} else if(in == '"') {
-				put_buf('"');
-			} else if(in == '0') {
-				put_buf('\0');
-			} else if(in == 'u') {
-				int ucs = get_utf16();
-				if(ucs < 0){
-					return NULL;
-				} else if((ucs & 0xfc00) == 0xd800) {
-					if(next() != '\\') {
-						cave_jsonc_report_error(gdoc, "代理对的转义必须成对存在，不能只有前半代理对", pos, 1);
-						free(buf);
-						return NULL;
-					}
-					if(next() != 'u') {
-						cave_jsonc_report_error(gdoc, "无效的代理对转义", pos, 1);
-						free(buf);
-						return NULL;
-					}
-					int unext = get_utf16();
-					if(unext < 0)
-						return NULL;
-					ucs = (((ucs & (~ 0xfc00)) << 10) + 0x10000) | (unext & (~ 0xfc00));
-				} else if((ucs & 0xfc00) == 0xdc00) {
-					cave_jsonc_report_error(gdoc, "代理对的转义必须成对存在，不能只有后半代理对", pos, 1);
-					free(buf);
-					return NULL;
-				}
-				if(ucs < 0x80) {
-					put_buf(ucs);
-				} else if(ucs < 0x800) {
-					put_buf((ucs >> 6) | 0xc0);
-					put_buf((ucs & 0x3f) | 0x80);
-				} else if(ucs < 0x10000){
-					put_buf((ucs >> 12) | 0xe0);
-					put_buf(((ucs >> 6) & 0x3f) | 0x80);
-					put_buf((ucs & 0x3f) | 0x80);
-				} else {// 受UTF-16编码特征的限制，它无法编码超过4字节的字符，故不再判断
-					put_buf((ucs >> 18) | 0xf0);
-					put_buf(((ucs >> 12) & 0x3f) | 0x80);
-					put_buf(((ucs >> 6) & 0x3f) | 0x80);
-					put_buf((ucs & 0x3f) | 0x80);
-				}
-			} else {
-				cave_jsonc_report_error(gdoc, "无效转义", pos, 1);
-				free(buf);
-				return NULL;
-			}
-		} else {
-			put_buf(in);
-		}
-		next();
-	} while(in != '"');
-	next();
-	put_buf('\0');
-	skip();
-	return alloc_string(realloc(buf, size), size - 1, CAVE_JSONC_STRING_LIFECYCLE_FREE);
+static int first_result(void *user, cave_jsonc_value value) {
+	*(cave_jsonc_value *) user = value;
+	return 1;
 }
 
-static cave_jsonc_value parse_value() {
-	cave_jsonc_position p = pos;
-	if(in < 0) {
-		cave_jsonc_report_error(gdoc, "意料之外的文件结束", pos, 1);
-		return NULL;
-	}
-	if(in == 'n') {
-		if(next() != 'u' || next() != 'l' || next() != 'l') {
-			cave_jsonc_report_error(gdoc, "无效内容", pos, 1);
-			return NULL;
-		}
-		next();
-		skip();
-		cave_jsonc_value rval = cave_jsonc_create_null_value(gdoc);
-		cave_jsonc_set_value_position(rval, p);
-		return rval;
-	} else if(in == 't') {
-		if(next() != 'r' || next() != 'u' || next() != 'e') {
-			cave_jsonc_report_error(gdoc, "无效内容", pos, 1);
-			return NULL;
-		}
-		next();
-		skip();
-		cave_jsonc_value rval = cave_jsonc_create_boolean_value(gdoc, 1);
-		cave_jsonc_set_value_position(rval, p);
-		return rval;
-	} else if(in == 'f') {
-		if(next() != 'a' || next() != 'l' || next() != 's' || next() != 'e') {
-			cave_jsonc_report_error(gdoc, "无效内容", pos, 1);
-			return NULL;
-		}
-		next();
-		skip();
-		cave_jsonc_value rval = cave_jsonc_create_boolean_value(gdoc, 0);
-		cave_jsonc_set_value_position(rval, p);
-		return rval;
-	} else if(in == '"') {
-		cave_jsonc_string string = get_string();
-		if(!string) {
-			return NULL;
-		}
-		cave_jsonc_value rval = alloc_value(gdoc, CAVE_JSONC_STRING);
-		cave_jsonc_set_value_position(rval, p);
-		rval->value.string = string;
-		return rval;
-	} else if((in >= '0' && in <= '9') || in == '-') {
-		cave_jsonc_value rval = parse_number();
-		if(!rval) {
+cave_jsonc_value cave_jsonc_path_get(cave_jsonc_path path, cave_jsonc_value value) {
+	cave_jsonc_value result = NULL;
+	path_walk(path, 0, value, first_result, &result);
+	return result;
+}
+
+size_t cave_jsonc_path_query(cave_jsonc_path path, cave_jsonc_value value, cave_jsonc_value *results, size_t capacity) {
+	struct path_results r = {results, 0, capacity};
+	path_walk(path, 0, value, collect_result, &r);
+	return r.size;
+}
+
+static int same_segment(const struct path_segment *a, const struct path_segment *b) {
+	return a->wildcard == b->wildcard && a->hash == b->hash && a->length == b->length && !memcmp(a->key, b->key, a->length);
+}
+
+cave_jsonc_path_set cave_jsonc_compile_path_set_with_options(const char *const *pointers, size_t count, int options) {
+	cave_jsonc_path_set set = calloc(1, sizeof(struct _cave_jsonc_path_set));
+	set->paths = calloc(count ? count : 1, sizeof(cave_jsonc_path));
+	set->path_next = malloc(sizeof(size_t) * (count ? count : 1));
+	size_t cap = 1;
+	for(size_t i = 0; i < count; i++)
+		cap += strlen(pointers[i]);
+	set->nodes = malloc(sizeof(struct path_node) * cap);
+	set->nodes[0] = (struct path_node) {NULL, 0, 0, SIZE_MAX};
+	set->node_count = 1;
+	set->count = count;
+	for(size_t i = 0; i < count; i++) {
+		cave_jsonc_path path = set->paths[i] = cave_jsonc_compile_path_with_options(pointers[i], strlen(pointers[i]), options);
+		if(!path) {
+			cave_jsonc_release_path_set(set);
 			return NULL;
 		}
-		cave_jsonc_set_value_position(rval, p);
-		return rval;
-	} else if(in == '{') {
-		cave_jsonc_value rval = cave_jsonc_create_object_value(gdoc);
-		cave_jsonc_set_value_position(rval, p);
-		while(in != '}') {
-			next();
-			skip();
-			if(in == '}') {
-				if(rval->value.object->head) {
-					cave_jsonc_report_error(gdoc, "多余的逗号", pos, 1);
-					return rval;
-				} else
-					break;
-			}
-			cave_jsonc_position kp = pos;
-			if(in != '"') {
-				cave_jsonc_report_error(gdoc, "键只能是字符串", pos, 1);
-				return rval;
-			}
-			cave_jsonc_string key = get_string();
-			if(!key)
-				return rval;
-			if(in < 0) {
-				release_string(key);
-				cave_jsonc_report_error(gdoc, "达到文件末尾对象键值对未定义完毕", pos, 1);
-				return rval;
-			} else if(in != ':') {
-				release_string(key);
-				cave_jsonc_report_error(gdoc, "键值之间应当使用冒号分隔", pos, 1);
-				return rval;
-			}
-			next();
-			skip();
-			if(cave_jsonc_has_fatal_error(gdoc)) {
-				release_string(key);
-				cave_jsonc_report_error(gdoc, "键值之间应当使用冒号分隔", pos, 1);
-				return rval;
-			}
-			cave_jsonc_value value = parse_value();
-			if(value) {
-				cave_jsonc_kvpair pair = malloc(sizeof(struct _cave_jsonc_kvpair));
-				pair->object = NULL;
-				pair->key = key;
-				pair->value = value;
-				pair->position = kp;
-				cave_jsonc_move_kvpair_to_object(pair, rval->value.object);
-				cave_jsonc_insert_last_kvpair(rval->value.object, pair);
-			} else {
-				release_string(key);
-				return rval;
-			}
-			if(cave_jsonc_has_fatal_error(gdoc))
-				return rval;
-			if(in < 0) {
-				cave_jsonc_report_error(gdoc, "达到文件末尾对象花括号仍未配对", pos, 1);
-				return rval;
-			} else if(in != ',' && in != '}') {
-				cave_jsonc_report_error(gdoc, "相邻键值对之间应当使用逗号分隔", pos, 1);
-				return rval;
-			}
-		}
-		next();
-		skip();
-		return rval;
-	} else if(in == '[') {
-		size_t length = 32, size = 0;
-		cave_jsonc_value *values = malloc(sizeof(cave_jsonc_value) * 32);
-		while(in != ']'){
-			next();
-			skip();
-			cave_jsonc_value value = parse_value();
-			if(value) {
-				if(size == length) {
-					length *= 2;
-					values = realloc(values, sizeof(cave_jsonc_value) * length);
-				}
-				values[size++] = value;
-			}
-			if(cave_jsonc_has_fatal_error(gdoc))
-				break;
-			if(in != ',' && in != ']') {
-				cave_jsonc_report_error(gdoc, "数组中相邻键之间应当使用逗号分隔", pos, 1);
-				break;
+		// 共同的前缀只走一次
+		size_t node = 0;
+		for(size_t j = 0; j < path->count; j++) {
+			size_t child = set->nodes[node].first_child;
+			while(child && !same_segment(set->nodes[child].segment, &path->segments[j]))
+				child = set->nodes[child].next_sibling;
+			if(!child) {
+				child = set->node_count++;
+				set->nodes[child] = (struct path_node) {&path->segments[j], 0, set->nodes[node].first_child, SIZE_MAX};
+				set->nodes[node].first_child = child;
 			}
+			node = child;
 		}
-		next();
-		skip();
-		cave_jsonc_value rval = alloc_value(gdoc, CAVE_JSONC_ARRAY);
-		cave_jsonc_set_value_position(rval, p);
-		rval->value.array = malloc(sizeof(struct _cave_jsonc_array));
-		rval->value.array->values = realloc(values, sizeof(cave_jsonc_value) * size);
-		rval->value.array->length = size;
-		return rval;
-	} else {
-		cave_jsonc_report_error(gdoc, "无法理解的内容", pos, 1);
-		return NULL;
+		set->path_next[i] = set->nodes[node].paths;
+		set->nodes[node].paths = i;
 	}
+	return set;
 }
 
-cave_jsonc_document cave_jsonc_parse_document(int (*fgetc)(void *file), void *file) {
-	pos = (cave_jsonc_position) {1, 1, 0};
-	gdoc = cave_jsonc_create_document();
-	ffgetc = fgetc;
-	ffile = file;
-	next();
-	cave_jsonc_set_document_root(gdoc, parse_value());
-	if(!cave_jsonc_has_fatal_error(gdoc) && in > 0)
-		cave_jsonc_report_error(gdoc, "解析完毕后文本仍有内容", pos, 1);
-	return gdoc;
-}
-
-static _Thread_local int (*ffputc)(int c, void *file);
-static _Thread_local void *fofile;
-void sfoprint(const char *str) {
-	for(size_t i = 0; str[i]; i++)
-		ffputc(str[i], fofile);
-}
-
-void serialize_string(cave_jsonc_string string) {
-	ffputc('"', fofile);
-	size_t p = 0;
-	while(p < string->length) {
-		if(!strncmp("\u200b", string->value + p, sizeof("\u200b") - 1)) {
-			sfoprint("\\u200b");
-			p += sizeof("\u200b") - 1;
-		} else if(!strncmp("\u200c", string->value + p, sizeof("\u200c") - 1)){
-			sfoprint("\\u200c");
-			p += sizeof("\u200c") - 1;
-		} else if(!strncmp("\u200d", string->value + p, sizeof("\u200d") - 1)) {
-			sfoprint("\\u200d");
-			p += sizeof("\u200d") - 1;
-		} else if(!strncmp("\u202a", string->value + p, sizeof("\u202a") - 1)) {
-			sfoprint("\\u202a");
-			p += sizeof("\u202a") - 1;
-		} else if(!strncmp("\u202b", string->value + p, sizeof("\u202b") - 1)) {
-			sfoprint("\\u202b");
-			p += sizeof("\u202b") - 1;
-		} else if(!strncmp("\u202c", string->value + p, sizeof("\u202c") - 1)) {
-			sfoprint("\\u202c");
-			p += sizeof("\u202c") - 1;
-		} else if(!strncmp("\u200d", string->value + p, sizeof("\u202d") - 1)) {
-			sfoprint("\\u202d");
-			p += sizeof("\u202d") - 1;
-		} else if(!strncmp("\u200e", string->value + p, sizeof("\u202e") - 1)) {
-			sfoprint("\\u202e");
-			p += sizeof("\u202e") - 1;
-		} else {
-			char value = string->value[p];
-			switch (value) {
-				case '\\':
-					sfoprint("\\");
-					break;
-				case '\n':
-					sfoprint("\\n");
-					break;
-				case '\r':
-					sfoprint("\\r");
-					break;
-				case '\t':
-					sfoprint("\\t");
-					break;
-				case '\b':
-					sfoprint("\\b");
-					break;
-				case '\f':
-					sfoprint("\\f");
-					break;
-				case '"':
-					sfoprint("\\\"");
-					break;
-				case '\0':
-					sfoprint("\\0");
-					break;
-				default:
-					if(value >= 0 && value <= 40) {
-						char head[7] = "\\u00";
-						head[4] = (value >> 4) + '0';
-						head[5] = (value & 15) >= 10 ? (value & 15) - 10 + 'a' : (value & 15) + '0';
-						head[6] = 0;
-						sfoprint(head);
-					} else
-						ffputc(value, fofile);
-			}
-			p++;
+cave_jsonc_path_set cave_jsonc_compile_path_set(const char *const *pointers, size_t count) {
+	return cave_jsonc_compile_path_set_with_options(pointers, count, 0);
+}
+
+void cave_jsonc_release_path_set(cave_jsonc_path_set set) {
+	if(!set)
+		return;
+	for(size_t i = 0; i < set->count; i++)
+		cave_jsonc_release_path(set->paths[i]);
+	free(set->paths);
+	free(set->nodes);
+	free(set->path_next);
+	free(set);
+}
+
+/**
+ * 在一次遍历中匹配前缀树的一个节点及其子树
+ */
+static int path_set_walk(cave_jsonc_path_set set, size_t node, cave_jsonc_value value,
+		int (*found)(void *user, size_t index, cave_jsonc_value value), void *user) {
+	for(size_t i = set->nodes[node].paths; i != SIZE_MAX; i = set->path_next[i])
+		if(found(user, i, value))
+			return 1;
+	for(size_t child = set->nodes[node].first_child; child; child = set->nodes[child].next_sibling) {
+		const struct path_segment *segment = set->nodes[child].segment;
+		if(!segment->wildcard) {
+			cave_jsonc_value next = path_step(segment, value);
+			if(next && path_set_walk(set, child, next, found, user))
+				return 1;
+		} else if(value->type == CAVE_JSONC_OBJECT) {
+			for(cave_jsonc_kvpair pair = cave_jsonc_get_object(value)->head; pair; pair = pair->next)
+				if(path_set_walk(set, child, pair->value, found, user))
+					return 1;
+		} else if(value->type == CAVE_JSONC_ARRAY) {
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			for(size_t j = 0; j < array->length; j++)
+				if(path_set_walk(set, child, array->values[j], found, user))
+					return 1;
 		}
 	}
-	ffputc('"', fofile);
+	return 0;
 }
 
-static void print_tab(int count) {
-	for(int i = 0; i < count; i++)
-		ffputc('\t', ffile);
+void cave_jsonc_path_set_query(cave_jsonc_path_set set, cave_jsonc_value value,
+		int (*found)(void *user, size_t index, cave_jsonc_value value), void *user) {
+	if(value)
+		path_set_walk(set, 0, value, found, user);
 }
 
-static void serialize_value(cave_jsonc_value value, int mininize, int tab) {
-	switch (cave_jsonc_get_value_type(value)) {
-		case CAVE_JSONC_UNDEFINED:
-		case CAVE_JSONC_NULL:
-			sfoprint("null");
-			break;
-		case CAVE_JSONC_BOOLEAN:
-			sfoprint(value->value.boolean ? "true" : "false");
-			break;
-		case CAVE_JSONC_NUMBER:
-			sfoprint(cave_jsonc_get_raw_number(value)->value);
-			break;
-		case CAVE_JSONC_STRING:
-			serialize_string(value->value.string);
-			break;
-		case CAVE_JSONC_OBJECT:
-			ffputc('{', ffile);
-			cave_jsonc_object object = value->value.object;
-			cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(object);
-			int first = 1;
-			while(pair) {
-				if(pair->value != NULL) {
-					if(!first)
-						ffputc(',', ffile);
-					if(!mininize) {
-						ffputc('\n', ffile);
-						print_tab(tab + 1);
-					}
-					first = 0;
-					serialize_string(pair->key);
-					if(!mininize)
-						ffputc(' ', ffile);
-					ffputc(':', ffile);
-					if(!mininize)
-						ffputc(' ', ffile);
-					serialize_value(pair->value, mininize, tab + 1);
-				}
-				pair = cave_jsonc_next_kvpair(pair);
-			}
-			if(!mininize && !first) {
-				ffputc('\n', ffile);
-				print_tab(tab);
-			}
-			ffputc('}', ffile);
-			break;
-		case CAVE_JSONC_ARRAY:
-			ffputc('[', ffile);
-			cave_jsonc_array array = value->value.array;
-			first = 1;
-			for(int i = 0; i < array->length; i++) {
-				if(!first)
-					ffputc(',', ffile);
-				if(!mininize)
-					ffputc(' ', ffile);
-				first = 0;
-				serialize_value(array->values[i], mininize, tab);
-			}
-			ffputc(']', ffile);
-			break;
+static int first_set_result(void *user, size_t index, cave_jsonc_value value) {
+	cave_jsonc_value *results = user;
+	if(!results[index])
+		results[index] = value;
+	return 0;
+}
+
+void cave_jsonc_path_set_get(cave_jsonc_path_set set, cave_jsonc_value value, cave_jsonc_value *results) {
+	for(size_t i = 0; i < set->count; i++)
+		results[i] = NULL;
+	cave_jsonc_path_set_query(set, value, first_set_result, results);
+}
+
+/**
+ * 构建树时每层容器的状态
+ * 对象直接创建，数组的元素先收集起来，结束时再创建
+ */
+struct value_frame {
+	cave_jsonc_value object;
+	cave_jsonc_string key;
+	cave_jsonc_position position, key_position;
+	cave_jsonc_value *values;
+	size_t length, cap;
+};
+
+/**
+ * 事件解析时每层容器的状态
+ */
+struct sax_frame {
+	int object;
+	size_t count;
+};
+
+/**
+ * 解析器的全部状态，一个解析器可以依次解析多个文档，不能同时用于两次解析
+ */
+struct _cave_jsonc_parser {
+	int in;
+	int (*ffgetc)(void *file);
+	void *ffile;
+	cave_jsonc_document doc;
+	cave_jsonc_position pos;
+	/**
+	 * 从内存解析时直接移动指针，ffgetc为NULL
+	 */
+	const unsigned char *src, *src_end;
+	/**
+	 * 字符串的暂存区，在两次解析之间保留
+	 */
+	char *buf;
+	size_t cap, size;
+	/**
+	 * 事件解析的回调，构建树时为NULL
+	 */
+	const cave_jsonc_sax_handler *sax;
+	void *sax_user;
+	/**
+	 * 正在解析的容器，在两次解析之间保留
+	 */
+	struct value_frame *frames;
+	size_t depth, frames_cap;
+	struct sax_frame *sax_frames;
+	size_t sax_depth, sax_cap;
+	/**
+	 * 容器的最大嵌套层数，0表示不限制
+	 */
+	size_t max_depth;
+	/**
+	 * 延迟解析模式下嵌套的容器只跳过不解析
+	 */
+	int lazy;
+	/**
+	 * 用这个解析器解析的文档共用的驻留表
+	 */
+	cave_jsonc_intern intern;
+#ifdef CAVE_JSONC_STATS
+	cave_jsonc_stats *stats;
+#endif
+};
+
+static inline int next(cave_jsonc_parser ps) {
+	if(ps->in == '\n') {
+		ps->pos.cols = 1;
+		ps->pos.row++;
 	}
+	ps->pos.index++;
+	ps->pos.cols++;
+	if(!ps->ffgetc)
+		return ps->in = ps->src < ps->src_end ? *ps->src++ : -1;
+	return ps->in = ps->ffgetc(ps->ffile);
 }
 
-int cave_jsonc_serialize_document(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file, int mininize) {
-	if(!doc->root)
-		return 0;
-	ffputc = fputc;
-	fofile = file;
-	serialize_value(cave_jsonc_get_document_root(doc), mininize, 0);
-	return 0;
+/**
+ * 从内存解析时把当前字符直接移到p，效果等同于连续调用next()
+ * 途经lines个换行，最后一个换行在last
+ */
+static inline void advance_lines_to(cave_jsonc_parser ps, const unsigned char *p, size_t lines, const unsigned char *last) {
+	ssize_t n = p - (ps->src - 1);
+	ps->pos.index += n;
+	if(lines) {
+		ps->pos.row += lines;
+		ps->pos.cols = p - last + 1;
+	} else
+		ps->pos.cols += n;
+	ps->src = p < ps->src_end ? p + 1 : ps->src_end;
+	ps->in = p < ps->src_end ? *p : -1;
 }
 
-static void ffputs(int (*fputc)(int c, void *file), void *file, const char *str) {
-	for(size_t i = 0; str[i]; i++)
-		fputc(str[i], file);
+/**
+ * 调用者保证当前字符到p之间没有换行
+ */
+static inline void advance_to(cave_jsonc_parser ps, const unsigned char *p) {
+	advance_lines_to(ps, p, 0, NULL);
 }
 
-int cave_jsonc_print_error(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file) {
-	cave_jsonc_error err = doc->error_head;
-	char head[100];
-	size_t count = 0;
-	while(err) {
-		if(err->position.row > 0 && err->position.cols > 0) {
-			if(err->fatal > 0)
-				sprintf(head, "%ld:%ld: 错误: ", err->position.row, err->position.cols);
-			else if (err->fatal == 0)
-				sprintf(head, "%ld:%ld: 警告: ", err->position.row, err->position.cols);
-			else
-				sprintf(head, "%ld:%ld: 信息: ", err->position.row, err->position.cols);
-		} else {
-			if(err->fatal > 0)
-				strcpy(head, "<未知>: 错误: ");
-			else if (err->fatal == 0)
-				strcpy(head, "<未知>: 警告: ");
-			else
-				strcpy(head, "<未知>: 信息: ");
+static inline int is_space(int c) {
+	return c == ' ' || c == '\r' || c == '\n' || c == '\t' || c == '\b';
+}
+
+static size_t count_lines(const unsigned char *p, const unsigned char *end, const unsigned char **last) {
+	size_t lines = 0;
+	while((p = memchr(p, '\n', end - p))) {
+		lines++;
+		*last = p++;
+	}
+	return lines;
+}
+
+enum {
+	SIMD_SCALAR,
+	SIMD_SSE2,
+	SIMD_AVX2,
+};
+
+/**
+ * 当前CPU支持的向量指令级别，各个内核第一次调用时据此选择实现
+ */
+static int simd_level() {
+#ifdef CAVE_JSONC_X86_SIMD
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+		return SIMD_AVX2;
+	if(__builtin_cpu_supports("sse2"))
+		return SIMD_SSE2;
+#endif
+	return SIMD_SCALAR;
+}
+
+/**
+ * 读取内核的函数指针，多个线程可能同时在选择实现
+ */
+#define SIMD_KERNEL(kernel) __atomic_load_n(&(kernel), __ATOMIC_RELAXED)
+
+/**
+ * 跳过空白的内核：返回p开始第一个非空白字节，并统计途经的换行
+ */
+typedef const unsigned char *(*skip_space_kernel)(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last);
+
+static const unsigned char *skip_space_scalar(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last) {
+	for(; p < end && is_space(*p); p++)
+		if(*p == '\n') {
+			++*lines;
+			*last = p;
 		}
-		ffputs(fputc, file, head);
-		ffputs(fputc, file, err->message);
-		fputc('\n', file);
-		count += err->fatal >= 0;
-		err = err->next;
+	return p;
+}
+
+#ifdef CAVE_JSONC_X86_SIMD
+/**
+ * mask中的每一位对应一个字节，非空白位之前的换行计入统计
+ */
+static inline const unsigned char *skip_space_block(const unsigned char *p, unsigned mask, unsigned newline,
+		size_t *lines, const unsigned char **last) {
+	if(mask)
+		newline &= (1u << __builtin_ctz(mask)) - 1;
+	if(newline) {
+		*lines += __builtin_popcount(newline);
+		*last = p + 31 - __builtin_clz(newline);
 	}
-	if(count) {
-		sprintf(head, "共 %ld 个错误或警告\n", count);
-		ffputs(fputc, file, head);
+	return mask ? p + __builtin_ctz(mask) : NULL;
+}
+
+__attribute__((target("sse2")))
+static const unsigned char *skip_space_sse2(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last) {
+	const __m128i sp = _mm_set1_epi8(' '), cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n'),
+		  tab = _mm_set1_epi8('\t'), bs = _mm_set1_epi8('\b');
+	for(; end - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) p);
+		__m128i nl = _mm_cmpeq_epi8(v, lf);
+		__m128i space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, cr)),
+				_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, tab), _mm_cmpeq_epi8(v, bs)), nl));
+		unsigned mask = ~(unsigned) _mm_movemask_epi8(space) & 0xffff;
+		const unsigned char *rval = skip_space_block(p, mask, _mm_movemask_epi8(nl), lines, last);
+		if(rval)
+			return rval;
 	}
-	return count;
+	return skip_space_scalar(p, end, lines, last);
 }
 
-int cave_jsonc_has_fatal_error(cave_jsonc_document doc) {
-	return doc->fatal;
+__attribute__((target("avx2")))
+static const unsigned char *skip_space_avx2(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last) {
+	const __m256i sp = _mm256_set1_epi8(' '), cr = _mm256_set1_epi8('\r'), lf = _mm256_set1_epi8('\n'),
+		  tab = _mm256_set1_epi8('\t'), bs = _mm256_set1_epi8('\b');
+	for(; end - p >= 32; p += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) p);
+		__m256i nl = _mm256_cmpeq_epi8(v, lf);
+		__m256i space = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(v, cr)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, tab), _mm256_cmpeq_epi8(v, bs)), nl));
+		unsigned mask = ~(unsigned) _mm256_movemask_epi8(space);
+		const unsigned char *rval = skip_space_block(p, mask, _mm256_movemask_epi8(nl), lines, last);
+		if(rval)
+			return rval;
+	}
+	return skip_space_sse2(p, end, lines, last);
 }
+#endif
 
-int cave_jsonc_report_error(cave_jsonc_document doc, const char *message, cave_jsonc_position position, int fatal) {
-	int rval = doc->fatal;
-	cave_jsonc_error err = malloc(sizeof(struct _cave_jsonc_error));
-	err->fatal = fatal;
-	err->message = message;
-	err->position = position;
-	err->next = NULL;
-	if(doc->error_tail)
-		doc->error_tail = doc->error_tail->next = err;
-	else
-		doc->error_head = doc->error_tail = err;
-	if(fatal)
-		doc->fatal = 1;
-	return rval;
+static const unsigned char *skip_space_dispatch(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last);
+static skip_space_kernel skip_space = skip_space_dispatch;
+
+/**
+ * 第一次调用时根据CPU选择内核，之后直接调用选中的内核
+ */
+static const unsigned char *skip_space_dispatch(const unsigned char *p, const unsigned char *end,
+		size_t *lines, const unsigned char **last) {
+	skip_space_kernel kernel = skip_space_scalar;
+#ifdef CAVE_JSONC_X86_SIMD
+	int level = simd_level();
+	if(level == SIMD_AVX2)
+		kernel = skip_space_avx2;
+	else if(level == SIMD_SSE2)
+		kernel = skip_space_sse2;
+#endif
+	__atomic_store_n(&skip_space, kernel, __ATOMIC_RELAXED);
+	return kernel(p, end, lines, last);
 }
 
-long long cave_jsonc_get_integer(cave_jsonc_value value) {
-	cave_jsonc_number num = value->value.number;
-	if(!(num->flag & CAVE_JSONC_NUM_IVAL)) {
-		if(num->flag & CAVE_JSONC_NUM_RAW)
-			sscanf(value->value.number->raw->value, "%lld", &num->ival);
-		else if(num->flag & CAVE_JSONC_NUM_FVAL)
-			num->ival = num->fval;
+/**
+ * skip()在内存解析时的实现，行列号与逐字符的实现完全一致
+ */
+static void skip_buffer(cave_jsonc_parser ps) {
+	while(is_space(ps->in)) {
+		size_t lines = 0;
+		const unsigned char *last = NULL;
+		const unsigned char *end = SIMD_KERNEL(skip_space)(ps->src - 1, ps->src_end, &lines, &last);
+		advance_lines_to(ps, end, lines, last);
+		if(ps->in != '/')
+			break;
+		cave_jsonc_position p = ps->pos;
+		if(next(ps) == '/') {
+			end = memchr(ps->src, '\n', ps->src_end - ps->src);
+			advance_to(ps, end ? end : ps->src_end);
+		} else if(ps->in == '*') {
+			end = ps->src;
+			while((end = memchr(end, '*', ps->src_end - end)) && end + 1 < ps->src_end && end[1] != '/')
+				end++;
+			end = end && end + 1 < ps->src_end ? end + 1 : ps->src_end;
+			lines = count_lines(ps->src - 1, end, &last);
+			advance_lines_to(ps, end, lines, last);
+			next(ps);
+		} else {
+			cave_jsonc_report_error(ps->doc, "无意义内容", p, 1);
+			break;
+		}
 	}
-	num->flag |= CAVE_JSONC_NUM_IVAL;
-	return num->ival;
 }
 
-double cave_jsonc_get_double(cave_jsonc_value value) {
-	cave_jsonc_number num = value->value.number;
-	if(!(num->flag & CAVE_JSONC_NUM_FVAL)) {
-		if(num->flag & CAVE_JSONC_NUM_RAW)
-			sscanf(value->value.number->raw->value, "%lf", &num->fval);
-		else if(num->flag & CAVE_JSONC_NUM_IVAL)
-			num->fval = num->ival;
+static void skip(cave_jsonc_parser ps) {
+	STAT_BEGIN(ps->stats);
+	if(!ps->ffgetc) {
+		skip_buffer(ps);
+	} else while(is_space(ps->in)) {
+		if(next(ps) == '/') {
+			cave_jsonc_position p = ps->pos;
+			int prev = ps->in;
+			if(next(ps) == '/') {
+				while(next(ps) != '\n' && ps->in >= 0);
+			} else if(ps->in == '*') {
+				while((next(ps) != '/' || prev != '*') && ps->in >= 0)
+					prev = ps->in;
+				next(ps);
+			} else {
+				cave_jsonc_report_error(ps->doc, "无意义内容", p, 1);
+				break;
+			}
+		}
 	}
-	num->flag |= CAVE_JSONC_NUM_FVAL;
-	return num->fval;
+	STAT_END(ps->stats, skip_ns);
 }
 
-static double scale_double(double in, int *out) {
-	int e = 0;
-	while(in >= 10) {
-		in /= 10;
-		e++;
+static void put_buf(cave_jsonc_parser ps, char c) {
+	ps->buf[ps->size++] = c;
+	if(ps->size == ps->cap) {
+		ps->cap *= 2;
+		STAT_ALLOC(ps->stats, ps->cap);
+		ps->buf = realloc(ps->buf, ps->cap);
 	}
-	while(in < 1) {
-		in *= 10;
-		e--;
+}
+
+/**
+ * 解析数字时暂存数字的文本，短的数字放在栈上
+ */
+struct number_text {
+	char *value;
+	size_t size, cap;
+	char stack[64];
+};
+
+static void put_number_text(struct number_text *text, char c) {
+	if(text->size + 1 == text->cap) {
+		text->cap *= 2;
+		if(text->value == text->stack) {
+			text->value = malloc(text->cap);
+			memcpy(text->value, text->stack, text->size);
+		} else
+			text->value = realloc(text->value, text->cap);
 	}
-	*out = e;
-	return in;
+	text->value[text->size++] = c;
 }
 
-static void internal_stringify_double(double dbl) {
-	char head[64];
-	sprintf(head, "%.12lf", dbl);
-	int end = strlen(head);
-	for(end--; head[end] == '0' && head[end - 1] != '.'; end--);
-	for(int i = 0; i <= end; i++)
-		put_buf(head[i]);
+static void release_number_text(struct number_text *text) {
+	if(text->value != text->stack)
+		free(text->value);
 }
 
-static void stringify_int(long long i) {
-	if(i == 0) {
-		put_buf('0');
-		return;
+/**
+ * 5^q的128位近似值，高64位在前，q从POW5_MIN_EXPONENT到POW5_MAX_EXPONENT
+ * q为负时向上取整，用于Eisel-Lemire算法
+ */
+#define POW5_MIN_EXPONENT (-342)
+#define POW5_MAX_EXPONENT 308
+
+static const uint64_t pow5_table[][2] = {
+	{0xeef453d6923bd65a, 0x113faa2906a13b3f},
+	{0x9558b4661b6565f8, 0x4ac7ca59a424c507},
+	{0xbaaee17fa23ebf76, 0x5d79bcf00d2df649},
+	{0xe95a99df8ace6f53, 0xf4d82c2c107973dc},
+	{0x91d8a02bb6c10594, 0x79071b9b8a4be869},
+	{0xb64ec836a47146f9, 0x9748e2826cdee284},
+	{0xe3e27a444d8d98b7, 0xfd1b1b2308169b25},
+	{0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7},
+	{0xb208ef855c969f4f, 0xbdbd2d335e51a935},
+	{0xde8b2b66b3bc4723, 0xad2c788035e61382},
+	{0x8b16fb203055ac76, 0x4c3bcb5021afcc31},
+	{0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d},
+	{0xd953e8624b85dd78, 0xd71d6dad34a2af0d},
+	{0x87d4713d6f33aa6b, 0x8672648c40e5ad68},
+	{0xa9c98d8ccb009506, 0x680efdaf511f18c2},
+	{0xd43bf0effdc0ba48, 0x0212bd1b2566def2},
+	{0x84a57695fe98746d, 0x014bb630f7604b57},
+	{0xa5ced43b7e3e9188, 0x419ea3bd35385e2d},
+	{0xcf42894a5dce35ea, 0x52064cac828675b9},
+	{0x818995ce7aa0e1b2, 0x7343efebd1940993},
+	{0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8},
+	{0xca66fa129f9b60a6, 0xd41a26e077774ef6},
+	{0xfd00b897478238d0, 0x8920b098955522b4},
+	{0x9e20735e8cb16382, 0x55b46e5f5d5535b0},
+	{0xc5a890362fddbc62, 0xeb2189f734aa831d},
+	{0xf712b443bbd52b7b, 0xa5e9ec7501d523e4},
+	{0x9a6bb0aa55653b2d, 0x47b233c92125366e},
+	{0xc1069cd4eabe89f8, 0x999ec0bb696e840a},
+	{0xf148440a256e2c76, 0xc00670ea43ca250d},
+	{0x96cd2a865764dbca, 0x380406926a5e5728},
+	{0xbc807527ed3e12bc, 0xc605083704f5ecf2},
+	{0xeba09271e88d976b, 0xf7864a44c633682e},
+	{0x93445b8731587ea3, 0x7ab3ee6afbe0211d},
+	{0xb8157268fdae9e4c, 0x5960ea05bad82964},
+	{0xe61acf033d1a45df, 0x6fb92487298e33bd},
+	{0x8fd0c16206306bab, 0xa5d3b6d479f8e056},
+	{0xb3c4f1ba87bc8696, 0x8f48a4899877186c},
+	{0xe0b62e2929aba83c, 0x331acdabfe94de87},
+	{0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14},
+	{0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9},
+	{0xdb71e91432b1a24a, 0xc9e82cd9f69d6150},
+	{0x892731ac9faf056e, 0xbe311c083a225cd2},
+	{0xab70fe17c79ac6ca, 0x6dbd630a48aaf406},
+	{0xd64d3d9db981787d, 0x092cbbccdad5b108},
+	{0x85f0468293f0eb4e, 0x25bbf56008c58ea5},
+	{0xa76c582338ed2621, 0xaf2af2b80af6f24e},
+	{0xd1476e2c07286faa, 0x1af5af660db4aee1},
+	{0x82cca4db847945ca, 0x50d98d9fc890ed4d},
+	{0xa37fce126597973c, 0xe50ff107bab528a0},
+	{0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8},
+	{0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a},
+	{0x9faacf3df73609b1, 0x77b191618c54e9ac},
+	{0xc795830d75038c1d, 0xd59df5b9ef6a2417},
+	{0xf97ae3d0d2446f25, 0x4b0573286b44ad1d},
+	{0x9becce62836ac577, 0x4ee367f9430aec32},
+	{0xc2e801fb244576d5, 0x229c41f793cda73f},
+	{0xf3a20279ed56d48a, 0x6b43527578c1110f},
+	{0x9845418c345644d6, 0x830a13896b78aaa9},
+	{0xbe5691ef416bd60c, 0x23cc986bc656d553},
+	{0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8},
+	{0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9},
+	{0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53},
+	{0xe858ad248f5c22c9, 0xd1b3400f8f9cff68},
+	{0x91376c36d99995be, 0x23100809b9c21fa1},
+	{0xb58547448ffffb2d, 0xabd40a0c2832a78a},
+	{0xe2e69915b3fff9f9, 0x16c90c8f323f516c},
+	{0x8dd01fad907ffc3b, 0xae3da7d97f6792e3},
+	{0xb1442798f49ffb4a, 0x99cd11cfdf41779c},
+	{0xdd95317f31c7fa1d, 0x40405643d711d583},
+	{0x8a7d3eef7f1cfc52, 0x482835ea666b2572},
+	{0xad1c8eab5ee43b66, 0xda3243650005eecf},
+	{0xd863b256369d4a40, 0x90bed43e40076a82},
+	{0x873e4f75e2224e68, 0x5a7744a6e804a291},
+	{0xa90de3535aaae202, 0x711515d0a205cb36},
+	{0xd3515c2831559a83, 0x0d5a5b44ca873e03},
+	{0x8412d9991ed58091, 0xe858790afe9486c2},
+	{0xa5178fff668ae0b6, 0x626e974dbe39a872},
+	{0xce5d73ff402d98e3, 0xfb0a3d212dc8128f},
+	{0x80fa687f881c7f8e, 0x7ce66634bc9d0b99},
+	{0xa139029f6a239f72, 0x1c1fffc1ebc44e80},
+	{0xc987434744ac874e, 0xa327ffb266b56220},
+	{0xfbe9141915d7a922, 0x4bf1ff9f0062baa8},
+	{0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9},
+	{0xc4ce17b399107c22, 0xcb550fb4384d21d3},
+	{0xf6019da07f549b2b, 0x7e2a53a146606a48},
+	{0x99c102844f94e0fb, 0x2eda7444cbfc426d},
+	{0xc0314325637a1939, 0xfa911155fefb5308},
+	{0xf03d93eebc589f88, 0x793555ab7eba27ca},
+	{0x96267c7535b763b5, 0x4bc1558b2f3458de},
+	{0xbbb01b9283253ca2, 0x9eb1aaedfb016f16},
+	{0xea9c227723ee8bcb, 0x465e15a979c1cadc},
+	{0x92a1958a7675175f, 0x0bfacd89ec191ec9},
+	{0xb749faed14125d36, 0xcef980ec671f667b},
+	{0xe51c79a85916f484, 0x82b7e12780e7401a},
+	{0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810},
+	{0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15},
+	{0xdfbdcece67006ac9, 0x67a791e093e1d49a},
+	{0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0},
+	{0xaecc49914078536d, 0x58fae9f773886e18},
+	{0xda7f5bf590966848, 0xaf39a475506a899e},
+	{0x888f99797a5e012d, 0x6d8406c952429603},
+	{0xaab37fd7d8f58178, 0xc8e5087ba6d33b83},
+	{0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64},
+	{0x855c3be0a17fcd26, 0x5cf2eea09a55067f},
+	{0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e},
+	{0xd0601d8efc57b08b, 0xf13b94daf124da26},
+	{0x823c12795db6ce57, 0x76c53d08d6b70858},
+	{0xa2cb1717b52481ed, 0x54768c4b0c64ca6e},
+	{0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09},
+	{0xfe5d54150b090b02, 0xd3f93b35435d7c4c},
+	{0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf},
+	{0xc6b8e9b0709f109a, 0x359ab6419ca1091b},
+	{0xf867241c8cc6d4c0, 0xc30163d203c94b62},
+	{0x9b407691d7fc44f8, 0x79e0de63425dcf1d},
+	{0xc21094364dfb5636, 0x985915fc12f542e4},
+	{0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d},
+	{0x979cf3ca6cec5b5a, 0xa705992ceecf9c42},
+	{0xbd8430bd08277231, 0x50c6ff782a838353},
+	{0xece53cec4a314ebd, 0xa4f8bf5635246428},
+	{0x940f4613ae5ed136, 0x871b7795e136be99},
+	{0xb913179899f68584, 0x28e2557b59846e3f},
+	{0xe757dd7ec07426e5, 0x331aeada2fe589cf},
+	{0x9096ea6f3848984f, 0x3ff0d2c85def7621},
+	{0xb4bca50b065abe63, 0x0fed077a756b53a9},
+	{0xe1ebce4dc7f16dfb, 0xd3e8495912c62894},
+	{0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c},
+	{0xb080392cc4349dec, 0xbd8d794d96aacfb3},
+	{0xdca04777f541c567, 0xecf0d7a0fc5583a0},
+	{0x89e42caaf9491b60, 0xf41686c49db57244},
+	{0xac5d37d5b79b6239, 0x311c2875c522ced5},
+	{0xd77485cb25823ac7, 0x7d633293366b828b},
+	{0x86a8d39ef77164bc, 0xae5dff9c02033197},
+	{0xa8530886b54dbdeb, 0xd9f57f830283fdfc},
+	{0xd267caa862a12d66, 0xd072df63c324fd7b},
+	{0x8380dea93da4bc60, 0x4247cb9e59f71e6d},
+	{0xa46116538d0deb78, 0x52d9be85f074e608},
+	{0xcd795be870516656, 0x67902e276c921f8b},
+	{0x806bd9714632dff6, 0x00ba1cd8a3db53b6},
+	{0xa086cfcd97bf97f3, 0x80e8a40eccd228a4},
+	{0xc8a883c0fdaf7df0, 0x6122cd128006b2cd},
+	{0xfad2a4b13d1b5d6c, 0x796b805720085f81},
+	{0x9cc3a6eec6311a63, 0xcbe3303674053bb0},
+	{0xc3f490aa77bd60fc, 0xbedbfc4411068a9c},
+	{0xf4f1b4d515acb93b, 0xee92fb5515482d44},
+	{0x991711052d8bf3c5, 0x751bdd152d4d1c4a},
+	{0xbf5cd54678eef0b6, 0xd262d45a78a0635d},
+	{0xef340a98172aace4, 0x86fb897116c87c34},
+	{0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0},
+	{0xbae0a846d2195712, 0x8974836059cca109},
+	{0xe998d258869facd7, 0x2bd1a438703fc94b},
+	{0x91ff83775423cc06, 0x7b6306a34627ddcf},
+	{0xb67f6455292cbf08, 0x1a3bc84c17b1d542},
+	{0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93},
+	{0x8e938662882af53e, 0x547eb47b7282ee9c},
+	{0xb23867fb2a35b28d, 0xe99e619a4f23aa43},
+	{0xdec681f9f4c31f31, 0x6405fa00e2ec94d4},
+	{0x8b3c113c38f9f37e, 0xde83bc408dd3dd04},
+	{0xae0b158b4738705e, 0x9624ab50b148d445},
+	{0xd98ddaee19068c76, 0x3badd624dd9b0957},
+	{0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6},
+	{0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c},
+	{0xd47487cc8470652b, 0x7647c3200069671f},
+	{0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073},
+	{0xa5fb0a17c777cf09, 0xf468107100525890},
+	{0xcf79cc9db955c2cc, 0x7182148d4066eeb4},
+	{0x81ac1fe293d599bf, 0xc6f14cd848405530},
+	{0xa21727db38cb002f, 0xb8ada00e5a506a7c},
+	{0xca9cf1d206fdc03b, 0xa6d90811f0e4851c},
+	{0xfd442e4688bd304a, 0x908f4a166d1da663},
+	{0x9e4a9cec15763e2e, 0x9a598e4e043287fe},
+	{0xc5dd44271ad3cdba, 0x40eff1e1853f29fd},
+	{0xf7549530e188c128, 0xd12bee59e68ef47c},
+	{0x9a94dd3e8cf578b9, 0x82bb74f8301958ce},
+	{0xc13a148e3032d6e7, 0xe36a52363c1faf01},
+	{0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1},
+	{0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9},
+	{0xbcb2b812db11a5de, 0x7415d448f6b6f0e7},
+	{0xebdf661791d60f56, 0x111b495b3464ad21},
+	{0x936b9fcebb25c995, 0xcab10dd900beec34},
+	{0xb84687c269ef3bfb, 0x3d5d514f40eea742},
+	{0xe65829b3046b0afa, 0x0cb4a5a3112a5112},
+	{0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab},
+	{0xb3f4e093db73a093, 0x59ed216765690f56},
+	{0xe0f218b8d25088b8, 0x306869c13ec3532c},
+	{0x8c974f7383725573, 0x1e414218c73a13fb},
+	{0xafbd2350644eeacf, 0xe5d1929ef90898fa},
+	{0xdbac6c247d62a583, 0xdf45f746b74abf39},
+	{0x894bc396ce5da772, 0x6b8bba8c328eb783},
+	{0xab9eb47c81f5114f, 0x066ea92f3f326564},
+	{0xd686619ba27255a2, 0xc80a537b0efefebd},
+	{0x8613fd0145877585, 0xbd06742ce95f5f36},
+	{0xa798fc4196e952e7, 0x2c48113823b73704},
+	{0xd17f3b51fca3a7a0, 0xf75a15862ca504c5},
+	{0x82ef85133de648c4, 0x9a984d73dbe722fb},
+	{0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba},
+	{0xcc963fee10b7d1b3, 0x318df905079926a8},
+	{0xffbbcfe994e5c61f, 0xfdf17746497f7052},
+	{0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633},
+	{0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0},
+	{0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0},
+	{0x9c1661a651213e2d, 0x06bea10ca65c084e},
+	{0xc31bfa0fe5698db8, 0x486e494fcff30a62},
+	{0xf3e2f893dec3f126, 0x5a89dba3c3efccfa},
+	{0x986ddb5c6b3a76b7, 0xf89629465a75e01c},
+	{0xbe89523386091465, 0xf6bbb397f1135823},
+	{0xee2ba6c0678b597f, 0x746aa07ded582e2c},
+	{0x94db483840b717ef, 0xa8c2a44eb4571cdc},
+	{0xba121a4650e4ddeb, 0x92f34d62616ce413},
+	{0xe896a0d7e51e1566, 0x77b020baf9c81d17},
+	{0x915e2486ef32cd60, 0x0ace1474dc1d122e},
+	{0xb5b5ada8aaff80b8, 0x0d819992132456ba},
+	{0xe3231912d5bf60e6, 0x10e1fff697ed6c69},
+	{0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1},
+	{0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2},
+	{0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde},
+	{0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b},
+	{0xad4ab7112eb3929d, 0x86c16c98d2c953c6},
+	{0xd89d64d57a607744, 0xe871c7bf077ba8b7},
+	{0x87625f056c7c4a8b, 0x11471cd764ad4972},
+	{0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf},
+	{0xd389b47879823479, 0x4aff1d108d4ec2c3},
+	{0x843610cb4bf160cb, 0xcedf722a585139ba},
+	{0xa54394fe1eedb8fe, 0xc2974eb4ee658828},
+	{0xce947a3da6a9273e, 0x733d226229feea32},
+	{0x811ccc668829b887, 0x0806357d5a3f525f},
+	{0xa163ff802a3426a8, 0xca07c2dcb0cf26f7},
+	{0xc9bcff6034c13052, 0xfc89b393dd02f0b5},
+	{0xfc2c3f3841f17c67, 0xbbac2078d443ace2},
+	{0x9d9ba7832936edc0, 0xd54b944b84aa4c0d},
+	{0xc5029163f384a931, 0x0a9e795e65d4df11},
+	{0xf64335bcf065d37d, 0x4d4617b5ff4a16d5},
+	{0x99ea0196163fa42e, 0x504bced1bf8e4e45},
+	{0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6},
+	{0xf07da27a82c37088, 0x5d767327bb4e5a4c},
+	{0x964e858c91ba2655, 0x3a6a07f8d510f86f},
+	{0xbbe226efb628afea, 0x890489f70a55368b},
+	{0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e},
+	{0x92c8ae6b464fc96f, 0x3b0b8bc90012929d},
+	{0xb77ada0617e3bbcb, 0x09ce6ebb40173744},
+	{0xe55990879ddcaabd, 0xcc420a6a101d0515},
+	{0x8f57fa54c2a9eab6, 0x9fa946824a12232d},
+	{0xb32df8e9f3546564, 0x47939822dc96abf9},
+	{0xdff9772470297ebd, 0x59787e2b93bc56f7},
+	{0x8bfbea76c619ef36, 0x57eb4edb3c55b65a},
+	{0xaefae51477a06b03, 0xede622920b6b23f1},
+	{0xdab99e59958885c4, 0xe95fab368e45eced},
+	{0x88b402f7fd75539b, 0x11dbcb0218ebb414},
+	{0xaae103b5fcd2a881, 0xd652bdc29f26a119},
+	{0xd59944a37c0752a2, 0x4be76d3346f0495f},
+	{0x857fcae62d8493a5, 0x6f70a4400c562ddb},
+	{0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952},
+	{0xd097ad07a71f26b2, 0x7e2000a41346a7a7},
+	{0x825ecc24c873782f, 0x8ed400668c0c28c8},
+	{0xa2f67f2dfa90563b, 0x728900802f0f32fa},
+	{0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9},
+	{0xfea126b7d78186bc, 0xe2f610c84987bfa8},
+	{0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9},
+	{0xc6ede63fa05d3143, 0x91503d1c79720dbb},
+	{0xf8a95fcf88747d94, 0x75a44c6397ce912a},
+	{0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba},
+	{0xc24452da229b021b, 0xfbe85badce996168},
+	{0xf2d56790ab41c2a2, 0xfae27299423fb9c3},
+	{0x97c560ba6b0919a5, 0xdccd879fc967d41a},
+	{0xbdb6b8e905cb600f, 0x5400e987bbc1c920},
+	{0xed246723473e3813, 0x290123e9aab23b68},
+	{0x9436c0760c86e30b, 0xf9a0b6720aaf6521},
+	{0xb94470938fa89bce, 0xf808e40e8d5b3e69},
+	{0xe7958cb87392c2c2, 0xb60b1d1230b20e04},
+	{0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2},
+	{0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3},
+	{0xe2280b6c20dd5232, 0x25c6da63c38de1b0},
+	{0x8d590723948a535f, 0x579c487e5a38ad0e},
+	{0xb0af48ec79ace837, 0x2d835a9df0c6d851},
+	{0xdcdb1b2798182244, 0xf8e431456cf88e65},
+	{0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff},
+	{0xac8b2d36eed2dac5, 0xe272467e3d222f3f},
+	{0xd7adf884aa879177, 0x5b0ed81dcc6abb0f},
+	{0x86ccbb52ea94baea, 0x98e947129fc2b4e9},
+	{0xa87fea27a539e9a5, 0x3f2398d747b36224},
+	{0xd29fe4b18e88640e, 0x8eec7f0d19a03aad},
+	{0x83a3eeeef9153e89, 0x1953cf68300424ac},
+	{0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7},
+	{0xcdb02555653131b6, 0x3792f412cb06794d},
+	{0x808e17555f3ebf11, 0xe2bbd88bbee40bd0},
+	{0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4},
+	{0xc8de047564d20a8b, 0xf245825a5a445275},
+	{0xfb158592be068d2e, 0xeed6e2f0f0d56712},
+	{0x9ced737bb6c4183d, 0x55464dd69685606b},
+	{0xc428d05aa4751e4c, 0xaa97e14c3c26b886},
+	{0xf53304714d9265df, 0xd53dd99f4b3066a8},
+	{0x993fe2c6d07b7fab, 0xe546a8038efe4029},
+	{0xbf8fdb78849a5f96, 0xde98520472bdd033},
+	{0xef73d256a5c0f77c, 0x963e66858f6d4440},
+	{0x95a8637627989aad, 0xdde7001379a44aa8},
+	{0xbb127c53b17ec159, 0x5560c018580d5d52},
+	{0xe9d71b689dde71af, 0xaab8f01e6e10b4a6},
+	{0x9226712162ab070d, 0xcab3961304ca70e8},
+	{0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22},
+	{0xe45c10c42a2b3b05, 0x8cb89a7db77c506a},
+	{0x8eb98a7a9a5b04e3, 0x77f3608e92adb242},
+	{0xb267ed1940f1c61c, 0x55f038b237591ed3},
+	{0xdf01e85f912e37a3, 0x6b6c46dec52f6688},
+	{0x8b61313bbabce2c6, 0x2323ac4b3b3da015},
+	{0xae397d8aa96c1b77, 0xabec975e0a0d081a},
+	{0xd9c7dced53c72255, 0x96e7bd358c904a21},
+	{0x881cea14545c7575, 0x7e50d64177da2e54},
+	{0xaa242499697392d2, 0xdde50bd1d5d0b9e9},
+	{0xd4ad2dbfc3d07787, 0x955e4ec64b44e864},
+	{0x84ec3c97da624ab4, 0xbd5af13bef0b113e},
+	{0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e},
+	{0xcfb11ead453994ba, 0x67de18eda5814af2},
+	{0x81ceb32c4b43fcf4, 0x80eacf948770ced7},
+	{0xa2425ff75e14fc31, 0xa1258379a94d028d},
+	{0xcad2f7f5359a3b3e, 0x096ee45813a04330},
+	{0xfd87b5f28300ca0d, 0x8bca9d6e188853fc},
+	{0x9e74d1b791e07e48, 0x775ea264cf55347e},
+	{0xc612062576589dda, 0x95364afe032a819e},
+	{0xf79687aed3eec551, 0x3a83ddbd83f52205},
+	{0x9abe14cd44753b52, 0xc4926a9672793543},
+	{0xc16d9a0095928a27, 0x75b7053c0f178294},
+	{0xf1c90080baf72cb1, 0x5324c68b12dd6339},
+	{0x971da05074da7bee, 0xd3f6fc16ebca5e04},
+	{0xbce5086492111aea, 0x88f4bb1ca6bcf585},
+	{0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6},
+	{0x9392ee8e921d5d07, 0x3aff322e62439fd0},
+	{0xb877aa3236a4b449, 0x09befeb9fad487c3},
+	{0xe69594bec44de15b, 0x4c2ebe687989a9b4},
+	{0x901d7cf73ab0acd9, 0x0f9d37014bf60a11},
+	{0xb424dc35095cd80f, 0x538484c19ef38c95},
+	{0xe12e13424bb40e13, 0x2865a5f206b06fba},
+	{0x8cbccc096f5088cb, 0xf93f87b7442e45d4},
+	{0xafebff0bcb24aafe, 0xf78f69a51539d749},
+	{0xdbe6fecebdedd5be, 0xb573440e5a884d1c},
+	{0x89705f4136b4a597, 0x31680a88f8953031},
+	{0xabcc77118461cefc, 0xfdc20d2b36ba7c3e},
+	{0xd6bf94d5e57a42bc, 0x3d32907604691b4d},
+	{0x8637bd05af6c69b5, 0xa63f9a49c2c1b110},
+	{0xa7c5ac471b478423, 0x0fcf80dc33721d54},
+	{0xd1b71758e219652b, 0xd3c36113404ea4a9},
+	{0x83126e978d4fdf3b, 0x645a1cac083126ea},
+	{0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4},
+	{0xcccccccccccccccc, 0xcccccccccccccccd},
+	{0x8000000000000000, 0x0000000000000000},
+	{0xa000000000000000, 0x0000000000000000},
+	{0xc800000000000000, 0x0000000000000000},
+	{0xfa00000000000000, 0x0000000000000000},
+	{0x9c40000000000000, 0x0000000000000000},
+	{0xc350000000000000, 0x0000000000000000},
+	{0xf424000000000000, 0x0000000000000000},
+	{0x9896800000000000, 0x0000000000000000},
+	{0xbebc200000000000, 0x0000000000000000},
+	{0xee6b280000000000, 0x0000000000000000},
+	{0x9502f90000000000, 0x0000000000000000},
+	{0xba43b74000000000, 0x0000000000000000},
+	{0xe8d4a51000000000, 0x0000000000000000},
+	{0x9184e72a00000000, 0x0000000000000000},
+	{0xb5e620f480000000, 0x0000000000000000},
+	{0xe35fa931a0000000, 0x0000000000000000},
+	{0x8e1bc9bf04000000, 0x0000000000000000},
+	{0xb1a2bc2ec5000000, 0x0000000000000000},
+	{0xde0b6b3a76400000, 0x0000000000000000},
+	{0x8ac7230489e80000, 0x0000000000000000},
+	{0xad78ebc5ac620000, 0x0000000000000000},
+	{0xd8d726b7177a8000, 0x0000000000000000},
+	{0x878678326eac9000, 0x0000000000000000},
+	{0xa968163f0a57b400, 0x0000000000000000},
+	{0xd3c21bcecceda100, 0x0000000000000000},
+	{0x84595161401484a0, 0x0000000000000000},
+	{0xa56fa5b99019a5c8, 0x0000000000000000},
+	{0xcecb8f27f4200f3a, 0x0000000000000000},
+	{0x813f3978f8940984, 0x4000000000000000},
+	{0xa18f07d736b90be5, 0x5000000000000000},
+	{0xc9f2c9cd04674ede, 0xa400000000000000},
+	{0xfc6f7c4045812296, 0x4d00000000000000},
+	{0x9dc5ada82b70b59d, 0xf020000000000000},
+	{0xc5371912364ce305, 0x6c28000000000000},
+	{0xf684df56c3e01bc6, 0xc732000000000000},
+	{0x9a130b963a6c115c, 0x3c7f400000000000},
+	{0xc097ce7bc90715b3, 0x4b9f100000000000},
+	{0xf0bdc21abb48db20, 0x1e86d40000000000},
+	{0x96769950b50d88f4, 0x1314448000000000},
+	{0xbc143fa4e250eb31, 0x17d955a000000000},
+	{0xeb194f8e1ae525fd, 0x5dcfab0800000000},
+	{0x92efd1b8d0cf37be, 0x5aa1cae500000000},
+	{0xb7abc627050305ad, 0xf14a3d9e40000000},
+	{0xe596b7b0c643c719, 0x6d9ccd05d0000000},
+	{0x8f7e32ce7bea5c6f, 0xe4820023a2000000},
+	{0xb35dbf821ae4f38b, 0xdda2802c8a800000},
+	{0xe0352f62a19e306e, 0xd50b2037ad200000},
+	{0x8c213d9da502de45, 0x4526f422cc340000},
+	{0xaf298d050e4395d6, 0x9670b12b7f410000},
+	{0xdaf3f04651d47b4c, 0x3c0cdd765f114000},
+	{0x88d8762bf324cd0f, 0xa5880a69fb6ac800},
+	{0xab0e93b6efee0053, 0x8eea0d047a457a00},
+	{0xd5d238a4abe98068, 0x72a4904598d6d880},
+	{0x85a36366eb71f041, 0x47a6da2b7f864750},
+	{0xa70c3c40a64e6c51, 0x999090b65f67d924},
+	{0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},
+	{0x82818f1281ed449f, 0xbff8f10e7a8921a4},
+	{0xa321f2d7226895c7, 0xaff72d52192b6a0d},
+	{0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490},
+	{0xfee50b7025c36a08, 0x02f236d04753d5b4},
+	{0x9f4f2726179a2245, 0x01d762422c946590},
+	{0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5},
+	{0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2},
+	{0x9b934c3b330c8577, 0x63cc55f49f88eb2f},
+	{0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb},
+	{0xf316271c7fc3908a, 0x8bef464e3945ef7a},
+	{0x97edd871cfda3a56, 0x97758bf0e3cbb5ac},
+	{0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317},
+	{0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd},
+	{0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a},
+	{0xb975d6b6ee39e436, 0xb3e2fd538e122b44},
+	{0xe7d34c64a9c85d44, 0x60dbbca87196b616},
+	{0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd},
+	{0xb51d13aea4a488dd, 0x6babab6398bdbe41},
+	{0xe264589a4dcdab14, 0xc696963c7eed2dd1},
+	{0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2},
+	{0xb0de65388cc8ada8, 0x3b25a55f43294bcb},
+	{0xdd15fe86affad912, 0x49ef0eb713f39ebe},
+	{0x8a2dbf142dfcc7ab, 0x6e3569326c784337},
+	{0xacb92ed9397bf996, 0x49c2c37f07965404},
+	{0xd7e77a8f87daf7fb, 0xdc33745ec97be906},
+	{0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3},
+	{0xa8acd7c0222311bc, 0xc40832ea0d68ce0c},
+	{0xd2d80db02aabd62b, 0xf50a3fa490c30190},
+	{0x83c7088e1aab65db, 0x792667c6da79e0fa},
+	{0xa4b8cab1a1563f52, 0x577001b891185938},
+	{0xcde6fd5e09abcf26, 0xed4c0226b55e6f86},
+	{0x80b05e5ac60b6178, 0x544f8158315b05b4},
+	{0xa0dc75f1778e39d6, 0x696361ae3db1c721},
+	{0xc913936dd571c84c, 0x03bc3a19cd1e38e9},
+	{0xfb5878494ace3a5f, 0x04ab48a04065c723},
+	{0x9d174b2dcec0e47b, 0x62eb0d64283f9c76},
+	{0xc45d1df942711d9a, 0x3ba5d0bd324f8394},
+	{0xf5746577930d6500, 0xca8f44ec7ee36479},
+	{0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb},
+	{0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e},
+	{0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e},
+	{0x95d04aee3b80ece5, 0xbba1f1d158724a12},
+	{0xbb445da9ca61281f, 0x2a8a6e45ae8edc97},
+	{0xea1575143cf97226, 0xf52d09d71a3293bd},
+	{0x924d692ca61be758, 0x593c2626705f9c56},
+	{0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c},
+	{0xe498f455c38b997a, 0x0b6dfb9c0f956447},
+	{0x8edf98b59a373fec, 0x4724bd4189bd5eac},
+	{0xb2977ee300c50fe7, 0x58edec91ec2cb657},
+	{0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed},
+	{0x8b865b215899f46c, 0xbd79e0d20082ee74},
+	{0xae67f1e9aec07187, 0xecd8590680a3aa11},
+	{0xda01ee641a708de9, 0xe80e6f4820cc9495},
+	{0x884134fe908658b2, 0x3109058d147fdcdd},
+	{0xaa51823e34a7eede, 0xbd4b46f0599fd415},
+	{0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a},
+	{0x850fadc09923329e, 0x03e2cf6bc604ddb0},
+	{0xa6539930bf6bff45, 0x84db8346b786151c},
+	{0xcfe87f7cef46ff16, 0xe612641865679a63},
+	{0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e},
+	{0xa26da3999aef7749, 0xe3be5e330f38f09d},
+	{0xcb090c8001ab551c, 0x5cadf5bfd3072cc5},
+	{0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6},
+	{0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa},
+	{0xc646d63501a1511d, 0xb281e1fd541501b8},
+	{0xf7d88bc24209a565, 0x1f225a7ca91a4226},
+	{0x9ae757596946075f, 0x3375788de9b06958},
+	{0xc1a12d2fc3978937, 0x0052d6b1641c83ae},
+	{0xf209787bb47d6b84, 0xc0678c5dbd23a49a},
+	{0x9745eb4d50ce6332, 0xf840b7ba963646e0},
+	{0xbd176620a501fbff, 0xb650e5a93bc3d898},
+	{0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe},
+	{0x93ba47c980e98cdf, 0xc66f336c36b10137},
+	{0xb8a8d9bbe123f017, 0xb80b0047445d4184},
+	{0xe6d3102ad96cec1d, 0xa60dc059157491e5},
+	{0x9043ea1ac7e41392, 0x87c89837ad68db2f},
+	{0xb454e4a179dd1877, 0x29babe4598c311fb},
+	{0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a},
+	{0x8ce2529e2734bb1d, 0x1899e4a65f58660c},
+	{0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f},
+	{0xdc21a1171d42645d, 0x76707543f4fa1f73},
+	{0x899504ae72497eba, 0x6a06494a791c53a8},
+	{0xabfa45da0edbde69, 0x0487db9d17636892},
+	{0xd6f8d7509292d603, 0x45a9d2845d3c42b6},
+	{0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2},
+	{0xa7f26836f282b732, 0x8e6cac7768d7141e},
+	{0xd1ef0244af2364ff, 0x3207d795430cd926},
+	{0x8335616aed761f1f, 0x7f44e6bd49e807b8},
+	{0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6},
+	{0xcd036837130890a1, 0x36dba887c37a8c0f},
+	{0x802221226be55a64, 0xc2494954da2c9789},
+	{0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c},
+	{0xc83553c5c8965d3d, 0x6f92829494e5acc7},
+	{0xfa42a8b73abbf48c, 0xcb772339ba1f17f9},
+	{0x9c69a97284b578d7, 0xff2a760414536efb},
+	{0xc38413cf25e2d70d, 0xfef5138519684aba},
+	{0xf46518c2ef5b8cd1, 0x7eb258665fc25d69},
+	{0x98bf2f79d5993802, 0xef2f773ffbd97a61},
+	{0xbeeefb584aff8603, 0xaafb550ffacfd8fa},
+	{0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38},
+	{0x952ab45cfa97a0b2, 0xdd945a747bf26183},
+	{0xba756174393d88df, 0x94f971119aeef9e4},
+	{0xe912b9d1478ceb17, 0x7a37cd5601aab85d},
+	{0x91abb422ccb812ee, 0xac62e055c10ab33a},
+	{0xb616a12b7fe617aa, 0x577b986b314d6009},
+	{0xe39c49765fdf9d94, 0xed5a7e85fda0b80b},
+	{0x8e41ade9fbebc27d, 0x14588f13be847307},
+	{0xb1d219647ae6b31c, 0x596eb2d8ae258fc8},
+	{0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb},
+	{0x8aec23d680043bee, 0x25de7bb9480d5854},
+	{0xada72ccc20054ae9, 0xaf561aa79a10ae6a},
+	{0xd910f7ff28069da4, 0x1b2ba1518094da04},
+	{0x87aa9aff79042286, 0x90fb44d2f05d0842},
+	{0xa99541bf57452b28, 0x353a1607ac744a53},
+	{0xd3fa922f2d1675f2, 0x42889b8997915ce8},
+	{0x847c9b5d7c2e09b7, 0x69956135febada11},
+	{0xa59bc234db398c25, 0x43fab9837e699095},
+	{0xcf02b2c21207ef2e, 0x94f967e45e03f4bb},
+	{0x8161afb94b44f57d, 0x1d1be0eebac278f5},
+	{0xa1ba1ba79e1632dc, 0x6462d92a69731732},
+	{0xca28a291859bbf93, 0x7d7b8f7503cfdcfe},
+	{0xfcb2cb35e702af78, 0x5cda735244c3d43e},
+	{0x9defbf01b061adab, 0x3a0888136afa64a7},
+	{0xc56baec21c7a1916, 0x088aaa1845b8fdd0},
+	{0xf6c69a72a3989f5b, 0x8aad549e57273d45},
+	{0x9a3c2087a63f6399, 0x36ac54e2f678864b},
+	{0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd},
+	{0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5},
+	{0x969eb7c47859e743, 0x9f644ae5a4b1b325},
+	{0xbc4665b596706114, 0x873d5d9f0dde1fee},
+	{0xeb57ff22fc0c7959, 0xa90cb506d155a7ea},
+	{0x9316ff75dd87cbd8, 0x09a7f12442d588f2},
+	{0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f},
+	{0xe5d3ef282a242e81, 0x8f1668c8a86da5fa},
+	{0x8fa475791a569d10, 0xf96e017d694487bc},
+	{0xb38d92d760ec4455, 0x37c981dcc395a9ac},
+	{0xe070f78d3927556a, 0x85bbe253f47b1417},
+	{0x8c469ab843b89562, 0x93956d7478ccec8e},
+	{0xaf58416654a6babb, 0x387ac8d1970027b2},
+	{0xdb2e51bfe9d0696a, 0x06997b05fcc0319e},
+	{0x88fcf317f22241e2, 0x441fece3bdf81f03},
+	{0xab3c2fddeeaad25a, 0xd527e81cad7626c3},
+	{0xd60b3bd56a5586f1, 0x8a71e223d8d3b074},
+	{0x85c7056562757456, 0xf6872d5667844e49},
+	{0xa738c6bebb12d16c, 0xb428f8ac016561db},
+	{0xd106f86e69d785c7, 0xe13336d701beba52},
+	{0x82a45b450226b39c, 0xecc0024661173473},
+	{0xa34d721642b06084, 0x27f002d7f95d0190},
+	{0xcc20ce9bd35c78a5, 0x31ec038df7b441f4},
+	{0xff290242c83396ce, 0x7e67047175a15271},
+	{0x9f79a169bd203e41, 0x0f0062c6e984d386},
+	{0xc75809c42c684dd1, 0x52c07b78a3e60868},
+	{0xf92e0c3537826145, 0xa7709a56ccdf8a82},
+	{0x9bbcc7a142b17ccb, 0x88a66076400bb691},
+	{0xc2abf989935ddbfe, 0x6acff893d00ea435},
+	{0xf356f7ebf83552fe, 0x0583f6b8c4124d43},
+	{0x98165af37b2153de, 0xc3727a337a8b704a},
+	{0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c},
+	{0xeda2ee1c7064130c, 0x1162def06f79df73},
+	{0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8},
+	{0xb9a74a0637ce2ee1, 0x6d953e2bd7173692},
+	{0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437},
+	{0x910ab1d4db9914a0, 0x1d9c9892400a22a2},
+	{0xb54d5e4a127f59c8, 0x2503beb6d00cab4b},
+	{0xe2a0b5dc971f303a, 0x2e44ae64840fd61d},
+	{0x8da471a9de737e24, 0x5ceaecfed289e5d2},
+	{0xb10d8e1456105dad, 0x7425a83e872c5f47},
+	{0xdd50f1996b947518, 0xd12f124e28f77719},
+	{0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f},
+	{0xace73cbfdc0bfb7b, 0x636cc64d1001550b},
+	{0xd8210befd30efa5a, 0x3c47f7e05401aa4e},
+	{0x8714a775e3e95c78, 0x65acfaec34810a71},
+	{0xa8d9d1535ce3b396, 0x7f1839a741a14d0d},
+	{0xd31045a8341ca07c, 0x1ede48111209a050},
+	{0x83ea2b892091e44d, 0x934aed0aab460432},
+	{0xa4e4b66b68b65d60, 0xf81da84d5617853f},
+	{0xce1de40642e3f4b9, 0x36251260ab9d668e},
+	{0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019},
+	{0xa1075a24e4421730, 0xb24cf65b8612f81f},
+	{0xc94930ae1d529cfc, 0xdee033f26797b627},
+	{0xfb9b7cd9a4a7443c, 0x169840ef017da3b1},
+	{0x9d412e0806e88aa5, 0x8e1f289560ee864e},
+	{0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2},
+	{0xf5b5d7ec8acb58a2, 0xae10af696774b1db},
+	{0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29},
+	{0xbff610b0cc6edd3f, 0x17fd090a58d32af3},
+	{0xeff394dcff8a948e, 0xddfc4b4cef07f5b0},
+	{0x95f83d0a1fb69cd9, 0x4abdaf101564f98e},
+	{0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1},
+	{0xea53df5fd18d5513, 0x84c86189216dc5ed},
+	{0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4},
+	{0xb7118682dbb66a77, 0x3fbc8c33221dc2a1},
+	{0xe4d5e82392a40515, 0x0fabaf3feaa5334a},
+	{0x8f05b1163ba6832d, 0x29cb4d87f2a7400e},
+	{0xb2c71d5bca9023f8, 0x743e20e9ef511012},
+	{0xdf78e4b2bd342cf6, 0x914da9246b255416},
+	{0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e},
+	{0xae9672aba3d0c320, 0xa184ac2473b529b1},
+	{0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e},
+	{0x8865899617fb1871, 0x7e2fa67c7a658892},
+	{0xaa7eebfb9df9de8d, 0xddbb901b98feeab7},
+	{0xd51ea6fa85785631, 0x552a74227f3ea565},
+	{0x8533285c936b35de, 0xd53a88958f87275f},
+	{0xa67ff273b8460356, 0x8a892abaf368f137},
+	{0xd01fef10a657842c, 0x2d2b7569b0432d85},
+	{0x8213f56a67f6b29b, 0x9c3b29620e29fc73},
+	{0xa298f2c501f45f42, 0x8349f3ba91b47b8f},
+	{0xcb3f2f7642717713, 0x241c70a936219a73},
+	{0xfe0efb53d30dd4d7, 0xed238cd383aa0110},
+	{0x9ec95d1463e8a506, 0xf4363804324a40aa},
+	{0xc67bb4597ce2ce48, 0xb143c6053edcd0d5},
+	{0xf81aa16fdc1b81da, 0xdd94b7868e94050a},
+	{0x9b10a4e5e9913128, 0xca7cf2b4191c8326},
+	{0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0},
+	{0xf24a01a73cf2dccf, 0xbc633b39673c8cec},
+	{0x976e41088617ca01, 0xd5be0503e085d813},
+	{0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18},
+	{0xec9c459d51852ba2, 0xddf8e7d60ed1219e},
+	{0x93e1ab8252f33b45, 0xcabb90e5c942b503},
+	{0xb8da1662e7b00a17, 0x3d6a751f3b936243},
+	{0xe7109bfba19c0c9d, 0x0cc512670a783ad4},
+	{0x906a617d450187e2, 0x27fb2b80668b24c5},
+	{0xb484f9dc9641e9da, 0xb1f9f660802dedf6},
+	{0xe1a63853bbd26451, 0x5e7873f8a0396973},
+	{0x8d07e33455637eb2, 0xdb0b487b6423e1e8},
+	{0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62},
+	{0xdc5c5301c56b75f7, 0x7641a140cc7810fb},
+	{0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d},
+	{0xac2820d9623bf429, 0x546345fa9fbdcd44},
+	{0xd732290fbacaf133, 0xa97c177947ad4095},
+	{0x867f59a9d4bed6c0, 0x49ed8eabcccc485d},
+	{0xa81f301449ee8c70, 0x5c68f256bfff5a74},
+	{0xd226fc195c6a2f8c, 0x73832eec6fff3111},
+	{0x83585d8fd9c25db7, 0xc831fd53c5ff7eab},
+	{0xa42e74f3d032f525, 0xba3e7ca8b77f5e55},
+	{0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb},
+	{0x80444b5e7aa7cf85, 0x7980d163cf5b81b3},
+	{0xa0555e361951c366, 0xd7e105bcc332621f},
+	{0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7},
+	{0xfa856334878fc150, 0xb14f98f6f0feb951},
+	{0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3},
+	{0xc3b8358109e84f07, 0x0a862f80ec4700c8},
+	{0xf4a642e14c6262c8, 0xcd27bb612758c0fa},
+	{0x98e7e9cccfbd7dbd, 0x8038d51cb897789c},
+	{0xbf21e44003acdd2c, 0xe0470a63e6bd56c3},
+	{0xeeea5d5004981478, 0x1858ccfce06cac74},
+	{0x95527a5202df0ccb, 0x0f37801e0c43ebc8},
+	{0xbaa718e68396cffd, 0xd30560258f54e6ba},
+	{0xe950df20247c83fd, 0x47c6b82ef32a2069},
+	{0x91d28b7416cdd27e, 0x4cdc331d57fa5441},
+	{0xb6472e511c81471d, 0xe0133fe4adf8e952},
+	{0xe3d8f9e563a198e5, 0x58180fddd97723a6},
+	{0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648},
+};
+
+/**
+ * 可以精确表示的10的幂，用于尾数不超过2^53的快速路径
+ */
+static const double exact_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define DOUBLE_INFINITY_BITS ((uint64_t) 0x7FF << 52)
+
+static inline int leading_zeros64(uint64_t x) {
+#ifdef __GNUC__
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+	for(; !(x >> 63); x <<= 1)
+		n++;
+	return n;
+#endif
+}
+
+/**
+ * 64位乘法，返回低64位，高64位写入high
+ */
+static inline uint64_t full_mul(uint64_t a, uint64_t b, uint64_t *high) {
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = (unsigned __int128) a * b;
+	*high = (uint64_t) (r >> 64);
+	return (uint64_t) r;
+#else
+	uint64_t al = (uint32_t) a, ah = a >> 32, bl = (uint32_t) b, bh = b >> 32;
+	uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+	uint64_t mid = (ll >> 32) + (uint32_t) lh + (uint32_t) hl;
+	*high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	return (mid << 32) | (uint32_t) ll;
+#endif
+}
+
+/**
+ * Eisel-Lemire算法：计算w*10^q最接近的double，结果的位模式写入bits（不含符号）
+ * 无法确定舍入方向时返回0，需要交给精确的实现
+ */
+static int eisel_lemire(uint64_t w, int q, uint64_t *bits) {
+	if(w == 0 || q < POW5_MIN_EXPONENT) {
+		*bits = 0;
+		return 1;
 	}
-	char stack[48];
-	int top = 0;
-	if(i < 0) {
-		put_buf('-');
-		i = -i;
+	if(q > POW5_MAX_EXPONENT) {
+		*bits = DOUBLE_INFINITY_BITS;
+		return 1;
+	}
+	int lz = leading_zeros64(w);
+	w <<= lz;
+	const uint64_t *p5 = pow5_table[q - POW5_MIN_EXPONENT];
+	uint64_t high, low = full_mul(w, p5[0], &high);
+	if((high & 0x1FF) == 0x1FF) {
+		uint64_t high2;
+		full_mul(w, p5[1], &high2);
+		low += high2;
+		if(high2 > low)
+			high++;
+		if(low == UINT64_MAX && (q < -27 || q > 55))
+			return 0;
 	}
-	for(;i; i /= 10)
-		stack[top++] = i % 10 + '0';
-	for(int j = top - 1; j >= 0; j--)
-		put_buf(stack[j]);
+	int upper = (int) (high >> 63);
+	uint64_t mantissa = high >> (upper + 9);
+	int power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + 1023;
+	if(power2 <= 0) {
+		// 非规格化数
+		if(-power2 + 1 >= 64) {
+			*bits = 0;
+			return 1;
+		}
+		mantissa >>= -power2 + 1;
+		mantissa += mantissa & 1;
+		mantissa >>= 1;
+		power2 = mantissa < ((uint64_t) 1 << 52) ? 0 : 1;
+		*bits = mantissa | (uint64_t) power2 << 52;
+		return 1;
+	}
+	// 恰好在两个double中间时向偶数舍入
+	if(low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upper + 9)) == high)
+		mantissa &= ~(uint64_t) 1;
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if(mantissa >= ((uint64_t) 2 << 52)) {
+		mantissa = (uint64_t) 1 << 52;
+		power2++;
+	}
+	mantissa &= ~((uint64_t) 1 << 52);
+	if(power2 >= 0x7FF) {
+		*bits = DOUBLE_INFINITY_BITS;
+		return 1;
+	}
+	*bits = mantissa | (uint64_t) power2 << 52;
+	return 1;
 }
 
-static void stringify_double(double dbl) {
-	if(dbl < 0) {
-		put_buf('-');
-		dbl = -dbl;
+/**
+ * 精确但较慢的转换，把小数点换成当前locale的再交给strtod
+ */
+static double fallback_strtod(const char *s, size_t length) {
+	const char *point = localeconv()->decimal_point;
+	size_t point_length = strlen(point);
+	char stack[128], *copy = length + point_length < sizeof(stack) ? stack : malloc(length + point_length + 1);
+	size_t size = 0;
+	for(size_t i = 0; i < length; i++) {
+		if(s[i] == '.') {
+			memcpy(copy + size, point, point_length);
+			size += point_length;
+		} else
+			copy[size++] = s[i];
+	}
+	copy[size] = '\0';
+	double result = strtod(copy, NULL);
+	if(copy != stack)
+		free(copy);
+	return result;
+}
+
+/**
+ * 把十进制浮点数文本转换为最接近的double，不受locale影响
+ * 先尝试精确的快速路径和Eisel-Lemire，都不行时交给fallback_strtod
+ */
+static double parse_double_text(const char *s, size_t length) {
+	const char *p = s, *end = s + length;
+	int negative = p < end && *p == '-';
+	p += negative;
+	uint64_t w = 0;
+	int digits = 0, any = 0, truncated = 0;
+	long exponent = 0;
+	for(; p < end && *p >= '0' && *p <= '9'; p++, any = 1) {
+		if(digits < 19) {
+			w = w * 10 + (*p - '0');
+			digits += w != 0;
+		} else {
+			truncated |= *p != '0';
+			exponent++;
+		}
+	}
+	if(p < end && *p == '.') {
+		for(p++; p < end && *p >= '0' && *p <= '9'; p++, any = 1) {
+			if(digits < 19) {
+				w = w * 10 + (*p - '0');
+				digits += w != 0;
+				exponent--;
+			} else
+				truncated |= *p != '0';
+		}
+	}
+	if(any && p < end && (*p == 'e' || *p == 'E')) {
+		p++;
+		int exponent_negative = p < end && *p == '-';
+		if(p < end && (*p == '-' || *p == '+'))
+			p++;
+		if(p == end || *p < '0' || *p > '9')
+			return fallback_strtod(s, length);
+		long e = 0;
+		for(; p < end && *p >= '0' && *p <= '9'; p++)
+			if(e < 100000)
+				e = e * 10 + (*p - '0');
+		exponent += exponent_negative ? -e : e;
+	}
+	if(!any || p != end)
+		return fallback_strtod(s, length);
+	double result;
+	uint64_t bits, check;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+	if(!truncated && w <= (uint64_t) 1 << 53 && exponent >= -22 && exponent <= 22) {
+		result = (double) w;
+		result = exponent < 0 ? result / exact_pow10[-exponent] : result * exact_pow10[exponent];
+		return negative ? -result : result;
+	}
+#endif
+	if(exponent < INT_MIN / 2 || exponent > INT_MAX / 2)
+		exponent = exponent < 0 ? INT_MIN / 2 : INT_MAX / 2;
+	if(!eisel_lemire(w, (int) exponent, &bits) ||
+			(truncated && (!eisel_lemire(w + 1, (int) exponent, &check) || check != bits)))
+		return fallback_strtod(s, length);
+	bits |= (uint64_t) negative << 63;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+/**
+ * 把十进制整数文本转换为long long，溢出时返回0
+ * -0不是整数，返回0后按浮点数解析为-0.0，与strtod一致
+ */
+static int parse_integer_text(const char *s, size_t length, long long *out) {
+	int negative = length && *s == '-';
+	unsigned long long value = 0, limit = negative ? (unsigned long long) LLONG_MAX + 1 : LLONG_MAX;
+	for(size_t i = negative; i < length; i++) {
+		unsigned digit = s[i] - '0';
+		if(digit > 9 || value > (limit - digit) / 10)
+			return 0;
+		value = value * 10 + digit;
 	}
-	int out;
-	double scaled = scale_double(dbl, &out);
-	if(out <= 6 && out >= -6) {
-		internal_stringify_double(dbl);
+	if(negative && !value)
+		return 0;
+	*out = negative ? (long long) (0 - value) : (long long) value;
+	return 1;
+}
+
+/**
+ * 按文本设置数字的值：没有小数点和指数且不溢出的是整数，其余的是浮点数
+ */
+static void decode_number_text(struct _cave_jsonc_number *num, const char *s, size_t length, int integer) {
+	if(integer && parse_integer_text(s, length, &num->ival)) {
+		num->flag = (num->flag & CAVE_JSONC_NUM_RAW) | CAVE_JSONC_NUM_IVAL;
 	} else {
-		internal_stringify_double(scaled);
-		put_buf('E');
-		stringify_int(out);
+		num->fval = parse_double_text(s, length);
+		num->flag = (num->flag & CAVE_JSONC_NUM_RAW) | CAVE_JSONC_NUM_FVAL;
 	}
 }
 
-cave_jsonc_string cave_jsonc_get_raw_number(cave_jsonc_value value) {
-	cave_jsonc_number num = value->value.number;
-	if(!(num->flag & CAVE_JSONC_NUM_RAW)) {
-		buf = malloc(256);
-		cap = 256;
-		size = 0;
-		if(num->flag & CAVE_JSONC_NUM_FVAL)
-			stringify_double(num->fval);
-		else if(num->flag & CAVE_JSONC_NUM_IVAL)
-			stringify_int(num->ival);
-		put_buf('\0');
-		num->raw = alloc_string(buf, size - 1, CAVE_JSONC_STRING_LIFECYCLE_FREE);
-		num->flag |= CAVE_JSONC_NUM_RAW;
+/**
+ * 读取一个数字的文本到text并校验格式，文本以\0结尾，出错时返回0
+ * integer表示数字是否没有小数部分和指数
+ */
+static int lex_number(cave_jsonc_parser ps, struct number_text *text, int *integer) {
+	cave_jsonc_position p = ps->pos;
+	text->value = text->stack;
+	text->cap = sizeof(text->stack);
+	text->size = 0;
+	*integer = 1;
+	put_number_text(text, ps->in);
+	while(next(ps) >= '0' && ps->in <= '9') 
+		put_number_text(text, ps->in);
+	if(ps->in == '.') {
+		if(text->value[text->size - 1] == '-') {
+			cave_jsonc_report_error(ps->doc, "小数点前必须要有整数部分", ps->pos, 1);
+			release_number_text(text);
+			return 0;
+		}
+		*integer = 0;
+		put_number_text(text, '.');
+		while(next(ps) >= '0' && ps->in <= '9') 
+			put_number_text(text, ps->in);
 	}
-	return num->raw;
+	if(ps->in == 'e' || ps->in == 'E') {
+		if(text->value[text->size - 1] == '.') {
+			cave_jsonc_report_error(ps->doc, "科学计数法小数点后必须要有小数部分", ps->pos, 1);
+			release_number_text(text);
+			return 0;
+		} else if(text->value[text->size - 1] == '-') {
+			cave_jsonc_report_error(ps->doc, "科学计数法必须要有有效数位", ps->pos, 1);
+			release_number_text(text);
+			return 0;
+		}
+		*integer = 0;
+		put_number_text(text, ps->in);
+		if(next(ps) == '-' || (ps->in >= '0' && ps->in <= '9'))
+			put_number_text(text, ps->in);
+		while(next(ps) >= '0' && ps->in <= '9') 
+			put_number_text(text, ps->in);
+	}
+	char last = text->value[text->size - 1];
+	if(last == '.') {
+		cave_jsonc_report_error(ps->doc, "小数点后必须要有小数部分", ps->pos, 1);
+		release_number_text(text);
+		return 0;
+	} else if(last == '-') {
+		cave_jsonc_report_error(ps->doc, "无意义的负号", ps->pos, 1);
+		release_number_text(text);
+		return 0;
+	} else if(last == 'e' || last == 'E') {
+		cave_jsonc_report_error(ps->doc, "科学计数法必须要有指数位", ps->pos, 1);
+		release_number_text(text);
+		return 0;
+	} else if((text->size >= 2 && text->value[0] == '0' && text->value[1] >= '0' && text->value[1] <= '9') ||
+			(text->size >= 3 && text->value[0] == '-' && text->value[1] == '0' && text->value[2] >= '0' && text->value[2] <= '9')) {
+		cave_jsonc_report_error(ps->doc, "数字不得有前导0", p, 1);
+		release_number_text(text);
+		return 0;
+	}
+	put_number_text(text, '\0');
+	skip(ps);
+	return 1;
 }
 
-int cave_jsonc_print_error_full(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file,
-		const char *filename, int (*fseek)(void *, size_t, int), int (*fgetc)(void *file), void *in) {
-	cave_jsonc_error err = doc->error_head;
-	char head[100];
-	size_t count = 0;
-	while(err) {
-		if(err->position.row > 0 && err->position.cols > 0) {
-			ffputs(fputc, file, filename);
-			if(err->fatal > 0)
-				sprintf(head, ":%ld:%ld: 错误: ", err->position.row, err->position.cols);
-			else if(err->fatal == 0)
-				sprintf(head, ":%ld:%ld: 警告: ", err->position.row, err->position.cols);
-			else
-				sprintf(head, ":%ld:%ld: 信息: ", err->position.row, err->position.cols);
-			ffputs(fputc, file, head);
-			ffputs(fputc, file, err->message);
-			fputc('\n', file);
-			fseek(in, err->position.index - err->position.cols + 1, SEEK_SET);
-			int out = 0, p = 1;
-			while(out != '\n' && out >= 0) {
-				fputc(out, file);
-				if(p == err->position.cols - 1)
-					ffputs(fputc, file, " !!这里!! ->> ");
-				p++;
-				out = fgetc(in);
+static cave_jsonc_value parse_number(cave_jsonc_parser ps) {
+	const unsigned char *start = ps->ffgetc ? NULL : ps->src - 1;
+	struct number_text text;
+	int integer;
+	if(!lex_number(ps, &text, &integer))
+		return NULL;
+	cave_jsonc_value rval = alloc_value(ps->doc, CAVE_JSONC_NUMBER);
+	struct _cave_jsonc_number *num = &rval->value.number;
+	num->flag = 0;
+	if(ps->doc->flags & CAVE_JSONC_DOCUMENT_RAW_NUMBER) {
+		num->flag = CAVE_JSONC_NUM_RAW;
+		if(!ps->ffgetc && (ps->doc->flags & CAVE_JSONC_DOCUMENT_BORROW))
+			num->raw = alloc_string(ps->doc, (const char *) start, text.size - 1, CAVE_JSONC_STRING_LIFECYCLE_NONE);
+		else
+			num->raw = alloc_string(ps->doc, text.value, text.size - 1, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	}
+	decode_number_text(num, text.value, text.size - 1, integer);
+	release_number_text(&text);
+	return rval;
+}
+
+static int get_utf16(cave_jsonc_parser ps) {
+	int ucs = 0;
+	for(int i = 0; i < 4; i++)
+		if(next(ps) < 0) {
+			cave_jsonc_report_error(ps->doc, "UTF-16转义字符解析到达文件末尾", ps->pos, 1);
+			return -1;
+		} else if(ps->in >= '0' && ps->in <='9') {
+			ucs = (ucs << 4) + (ps->in - '0');
+		} else if (ps->in >= 'a' && ps->in <= 'f') {
+			ucs = (ucs << 4) + (ps->in - 'a' + 10);
+		} else if (ps->in >= 'A' && ps->in <= 'F') {
+			ucs = (ucs << 4) + (ps->in - 'A' + 10);
+		} else {
+			cave_jsonc_report_error(ps->doc, "UTF-16转义字符必须以四位十六进制数表示", ps->pos, 1);
+			return -1;
+		}
+	return ucs;
+}
+
+/**
+ * 找到字符串中下一个需要特殊处理的字节：引号、反斜杠或控制字符（包括换行）
+ * 在此之前的字节可以原样整段复制
+ */
+typedef const unsigned char *(*string_special_kernel)(const unsigned char *p, const unsigned char *end);
+
+static const unsigned char *find_string_special_scalar(const unsigned char *p, const unsigned char *end) {
+	while(p < end && *p != '"' && *p != '\\' && *p >= 0x20)
+		p++;
+	return p;
+}
+
+#ifdef CAVE_JSONC_X86_SIMD
+__attribute__((target("sse2")))
+static const unsigned char *find_string_special_sse2(const unsigned char *p, const unsigned char *end) {
+	const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), control = _mm_set1_epi8(0x1f);
+	for(; end - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) p);
+		__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+				_mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+		unsigned mask = _mm_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_string_special_scalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const unsigned char *find_string_special_avx2(const unsigned char *p, const unsigned char *end) {
+	const __m256i quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\'), control = _mm256_set1_epi8(0x1f);
+	for(; end - p >= 32; p += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) p);
+		__m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+				_mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control));
+		unsigned mask = _mm256_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_string_special_sse2(p, end);
+}
+#endif
+
+static const unsigned char *find_string_special_dispatch(const unsigned char *p, const unsigned char *end);
+static string_special_kernel find_string_special = find_string_special_dispatch;
+
+static const unsigned char *find_string_special_dispatch(const unsigned char *p, const unsigned char *end) {
+	string_special_kernel kernel = find_string_special_scalar;
+#ifdef CAVE_JSONC_X86_SIMD
+	int level = simd_level();
+	if(level == SIMD_AVX2)
+		kernel = find_string_special_avx2;
+	else if(level == SIMD_SSE2)
+		kernel = find_string_special_sse2;
+#endif
+	__atomic_store_n(&find_string_special, kernel, __ATOMIC_RELAXED);
+	return kernel(p, end);
+}
+
+/**
+ * 把一段不需要转义处理的字节整段放进buf
+ */
+static void put_buf_run(cave_jsonc_parser ps, const unsigned char *p, size_t n) {
+	if(ps->size + n >= ps->cap) {
+		while(ps->size + n >= ps->cap)
+			ps->cap *= 2;
+		STAT_ALLOC(ps->stats, ps->cap);
+		ps->buf = realloc(ps->buf, ps->cap);
+	}
+	memcpy(ps->buf + ps->size, p, n);
+	ps->size += n;
+	STAT_ADD(ps->stats, string_bytes_copied, n);
+}
+
+/**
+ * 读取一个字符串，成功时value和length指向它的内容，出错时返回0
+ * borrow非0且从内存解析时，没有转义的字符串直接指向源缓冲区并返回2，否则内容在buf中并返回1
+ * buf在需要时分配，由调用者接管或在解析结束时释放
+ */
+static int lex_string(cave_jsonc_parser ps, int borrow, const char **value, size_t *length) {
+	if(borrow && !ps->ffgetc) {
+		// 没有转义的字符串直接指向源缓冲区
+		const unsigned char *start = ps->src, *end = SIMD_KERNEL(find_string_special)(ps->src, ps->src_end);
+		if(end < ps->src_end && *end == '"') {
+			advance_to(ps, end);
+			next(ps);
+			skip(ps);
+			*value = (const char *) start;
+			*length = end - start;
+			return 2;
+		}
+	}
+	if(!ps->buf) {
+		ps->cap = 256;
+		STAT_ALLOC(ps->stats, ps->cap);
+		ps->buf = malloc(ps->cap);
+	}
+	ps->size = 0;
+	next(ps);// 跳过引号
+	while(ps->in != '"') {
+		if(!ps->ffgetc && ps->in >= 0x20 && ps->in != '\\') {
+			// 从内存解析时整段复制不含转义的部分
+			const unsigned char *end = SIMD_KERNEL(find_string_special)(ps->src - 1, ps->src_end);
+			put_buf_run(ps, ps->src - 1, end - (ps->src - 1));
+			advance_to(ps, end);
+			continue;
+		}
+		if(ps->in < 0) {
+			cave_jsonc_report_error(ps->doc, "引号在文件末尾仍未配对", ps->pos, 1);
+			return 0;
+		} else if(ps->in == '\n') {
+			cave_jsonc_report_error(ps->doc, "不能跨行书写字符串", ps->pos, 1);
+			return 0;
+		}
+		if(ps->in == '\\') {
+			size_t escaped = ps->size;
+			if(next(ps) == '\\') {
+				put_buf(ps, '\\');
+			} else if(ps->in == 'n') {
+				put_buf(ps, '\n');
+			} else if(ps->in == 'r') {
+				put_buf(ps, '\r');
+			} else if(ps->in == 't') {
+				put_buf(ps, '\t');
+			} else if(ps->in == 'b') {
+				put_buf(ps, '\b');
+			} else if(ps->in == 'f') {
+				put_buf(ps, '\f');
+			} else if(ps->in == '/') {
+				put_buf(ps, '/');
+			} else if(ps->in == '\'') {
+				put_buf(ps, '\'');
+			} else if(ps->in == '"') {
+				put_buf(ps, '"');
+			} else if(ps->in == '0') {
+				put_buf(ps, '\0');
+			} else if(ps->in == 'u') {
+				int ucs = get_utf16(ps);
+				if(ucs < 0){
+					return 0;
+				} else if((ucs & 0xfc00) == 0xd800) {
+					if(next(ps) != '\\') {
+						cave_jsonc_report_error(ps->doc, "代理对的转义必须成对存在，不能只有前半代理对", ps->pos, 1);
+						return 0;
+					}
+					if(next(ps) != 'u') {
+						cave_jsonc_report_error(ps->doc, "无效的代理对转义", ps->pos, 1);
+						return 0;
+					}
+					int unext = get_utf16(ps);
+					if(unext < 0)
+						return 0;
+					ucs = (((ucs & (~ 0xfc00)) << 10) + 0x10000) | (unext & (~ 0xfc00));
+				} else if((ucs & 0xfc00) == 0xdc00) {
+					cave_jsonc_report_error(ps->doc, "代理对的转义必须成对存在，不能只有后半代理对", ps->pos, 1);
+					return 0;
+				}
+				if(ucs < 0x80) {
+					put_buf(ps, ucs);
+				} else if(ucs < 0x800) {
+					put_buf(ps, (ucs >> 6) | 0xc0);
+					put_buf(ps, (ucs & 0x3f) | 0x80);
+				} else if(ucs < 0x10000){
+					put_buf(ps, (ucs >> 12) | 0xe0);
+					put_buf(ps, ((ucs >> 6) & 0x3f) | 0x80);
+					put_buf(ps, (ucs & 0x3f) | 0x80);
+				} else {// 受UTF-16编码特征的限制，它无法编码超过4字节的字符，故不再判断
+					put_buf(ps, (ucs >> 18) | 0xf0);
+					put_buf(ps, ((ucs >> 12) & 0x3f) | 0x80);
+					put_buf(ps, ((ucs >> 6) & 0x3f) | 0x80);
+					put_buf(ps, (ucs & 0x3f) | 0x80);
+				}
+			} else {
+				cave_jsonc_report_error(ps->doc, "无效转义", ps->pos, 1);
+				return 0;
 			}
-			fputc('\n', file);
-			fputc('\n', file);
+			STAT_ADD(ps->stats, string_bytes_escaped, ps->size - escaped);
 		} else {
-			if(err->fatal > 0)
-				ffputs(fputc, file, "<未知>: 错误: ");
-			else if(err->fatal == 0)
-				ffputs(fputc, file, "<未知>: 警告: ");
-			else
-				ffputs(fputc, file, "<未知>: 信息: ");
-			ffputs(fputc, file, err->message);
-			ffputs(fputc, file, "\n\t<无源代码>\n\n");
+			put_buf(ps, ps->in);
+			STAT_ADD(ps->stats, string_bytes_copied, 1);
 		}
-		count += err->fatal >= 0;
-		err = err->next;
+		next(ps);
 	}
-	if(count) {
-		sprintf(head, "共 %ld 个错误或警告\n", count);
-		ffputs(fputc, file, head);
+	next(ps);
+	put_buf(ps, '\0');
+	skip(ps);
+	*value = ps->buf;
+	*length = ps->size - 1;
+	return 1;
+}
+
+static cave_jsonc_string get_string(cave_jsonc_parser ps, int key) {
+	const char *value;
+	size_t length;
+	int lexed = lex_string(ps, ps->doc->flags & (CAVE_JSONC_DOCUMENT_BORROW | CAVE_JSONC_DOCUMENT_INTERN), &value, &length);
+	if(!lexed)
+		return NULL;
+	if(ps->doc->intern && (key || length <= INTERN_MAX_VALUE))
+		return intern_string(ps->doc->intern, lexed == 2 ? value : ps->buf, length);
+	if(lexed == 2 && !(ps->doc->flags & CAVE_JSONC_DOCUMENT_BORROW)) {
+		STAT_ADD(ps->stats, string_bytes_copied, length);
+		return alloc_string(ps->doc, value, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
 	}
-	return count;
+	if(lexed == 2)
+		return alloc_string(ps->doc, value, length, CAVE_JSONC_STRING_LIFECYCLE_NONE);
+	if(is_arena(ps->doc))
+		return alloc_string(ps->doc, ps->buf, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	// 把buf交给字符串，下一个字符串重新分配
+	char *owned = realloc(ps->buf, ps->size);
+	ps->buf = NULL;
+	return alloc_string(ps->doc, owned, length, CAVE_JSONC_STRING_LIFECYCLE_FREE);
 }
 
-void cave_jsonc_warn_value(cave_jsonc_value value, const char *message, int fatal) {
-	cave_jsonc_report_error(value->document, message, value->position, fatal);
+/**
+ * 用收集好的元素创建数组，接管values
+ */
+static cave_jsonc_value make_array(cave_jsonc_document doc, cave_jsonc_value *values, size_t size, cave_jsonc_position p) {
+	cave_jsonc_value rval = alloc_value(doc, CAVE_JSONC_ARRAY);
+	cave_jsonc_set_value_position(rval, p);
+	rval->value.array = doc_alloc(doc, sizeof(struct _cave_jsonc_array));
+	if(is_arena(doc)) {
+		rval->value.array->values = arena_alloc(doc, sizeof(cave_jsonc_value) * size);
+		memcpy(rval->value.array->values, values, sizeof(cave_jsonc_value) * size);
+		free(values);
+	} else
+		rval->value.array->values = realloc(values, sizeof(cave_jsonc_value) * size);
+	rval->value.array->length = size;
+	return rval;
 }
 
-void cave_jsonc_warn_key(cave_jsonc_kvpair pair, const char *message, int fatal) {
-	cave_jsonc_report_error(pair->object->value->document, message, pair->position, fatal);
+/**
+ * 校验null、true、false在首字母之后的部分
+ */
+static int lex_literal(cave_jsonc_parser ps, const char *rest) {
+	for(; *rest; rest++)
+		if(next(ps) != *rest) {
+			cave_jsonc_report_error(ps->doc, "无效内容", ps->pos, 1);
+			return 0;
+		}
+	next(ps);
+	skip(ps);
+	return 1;
+}
+
+/**
+ * 解析不是容器的值，出错时返回NULL
+ */
+static cave_jsonc_value parse_scalar(cave_jsonc_parser ps) {
+	cave_jsonc_position p = ps->pos;
+	if(ps->in < 0) {
+		cave_jsonc_report_error(ps->doc, "意料之外的文件结束", ps->pos, 1);
+		return NULL;
+	}
+	if(ps->in == 'n') {
+		if(!lex_literal(ps, "ull"))
+			return NULL;
+		cave_jsonc_value rval = cave_jsonc_create_null_value(ps->doc);
+		cave_jsonc_set_value_position(rval, p);
+		STAT_ADD(ps->stats, nodes[CAVE_JSONC_NULL], 1);
+		return rval;
+	} else if(ps->in == 't') {
+		if(!lex_literal(ps, "rue"))
+			return NULL;
+		cave_jsonc_value rval = cave_jsonc_create_boolean_value(ps->doc, 1);
+		cave_jsonc_set_value_position(rval, p);
+		STAT_ADD(ps->stats, nodes[CAVE_JSONC_BOOLEAN], 1);
+		return rval;
+	} else if(ps->in == 'f') {
+		if(!lex_literal(ps, "alse"))
+			return NULL;
+		cave_jsonc_value rval = cave_jsonc_create_boolean_value(ps->doc, 0);
+		cave_jsonc_set_value_position(rval, p);
+		STAT_ADD(ps->stats, nodes[CAVE_JSONC_BOOLEAN], 1);
+		return rval;
+	} else if(ps->in == '"') {
+		STAT_BEGIN(ps->stats);
+		cave_jsonc_string string = get_string(ps, 0);
+		STAT_END(ps->stats, string_ns);
+		if(!string) {
+			return NULL;
+		}
+		cave_jsonc_value rval = alloc_value(ps->doc, CAVE_JSONC_STRING);
+		cave_jsonc_set_value_position(rval, p);
+		rval->value.string = string;
+		STAT_ADD(ps->stats, nodes[CAVE_JSONC_STRING], 1);
+		return rval;
+	} else if((ps->in >= '0' && ps->in <= '9') || ps->in == '-') {
+		STAT_BEGIN(ps->stats);
+		cave_jsonc_value rval = parse_number(ps);
+		STAT_END(ps->stats, number_ns);
+		if(!rval) {
+			return NULL;
+		}
+		cave_jsonc_set_value_position(rval, p);
+		STAT_ADD(ps->stats, nodes[CAVE_JSONC_NUMBER], 1);
+		return rval;
+	} else {
+		cave_jsonc_report_error(ps->doc, "无法理解的内容", ps->pos, 1);
+		return NULL;
+	}
+}
+
+struct structural_index;
+static const unsigned char *match_bracket(const unsigned char *data, size_t length, size_t open, struct structural_index *index);
+
+/**
+ * 延迟解析时跳过一个容器，只记下它的位置和右括号的偏移，之后的状态和解析完这个容器相同
+ * 无法确定容器的结束位置时返回NULL，由完整的解析报告错误
+ */
+static cave_jsonc_value skim_container(cave_jsonc_parser ps) {
+	const unsigned char *source = (const unsigned char *) ps->doc->source, *open = ps->src - 1;
+	const unsigned char *close = match_bracket(source, ps->src_end - source, open - source, NULL);
+	if(!close)
+		return NULL;
+	cave_jsonc_value value = alloc_value(ps->doc, ps->in == '{' ? CAVE_JSONC_OBJECT : CAVE_JSONC_ARRAY);
+	cave_jsonc_set_value_position(value, ps->pos);
+	value->value.lazy.container = NULL;
+	value->value.lazy.end = close - source;
+	// 延迟解析从第0层开始，之前已经用掉的层数从限制中扣除
+	value->value.lazy.max_depth = ps->max_depth ? ps->max_depth - ps->depth : 0;
+	const unsigned char *last = NULL;
+	ps->pos.row += count_lines(open, close, &last);
+	ps->pos.cols = last ? close - last + 1 : ps->pos.cols + (close - open);
+	ps->pos.index += close - open;
+	ps->src = close + 1;
+	ps->in = *close;
+	next(ps);
+	skip(ps);
+	return value;
+}
+
+/**
+ * 嵌套层数超过限制时报告错误并返回非0
+ */
+static int check_depth(cave_jsonc_parser ps, size_t depth) {
+	if(!ps->max_depth || depth < ps->max_depth)
+		return 0;
+	cave_jsonc_report_error(ps->doc, "嵌套层数超过限制", ps->pos, 1);
+	return 1;
+}
+
+static struct value_frame *push_value_frame(cave_jsonc_parser ps, cave_jsonc_position position) {
+	if(ps->depth == ps->frames_cap) {
+		ps->frames_cap = ps->frames_cap ? ps->frames_cap * 2 : 16;
+		STAT_ALLOC(ps->stats, sizeof(struct value_frame) * ps->frames_cap);
+		ps->frames = realloc(ps->frames, sizeof(struct value_frame) * ps->frames_cap);
+	}
+	struct value_frame *frame = &ps->frames[ps->depth++];
+	STAT_MAX(ps->stats, max_depth, ps->depth);
+	frame->object = NULL;
+	frame->key = NULL;
+	frame->position = position;
+	frame->values = NULL;
+	frame->length = frame->cap = 0;
+	return frame;
+}
+
+/**
+ * 读取对象的下一个键直到冒号之后，需要解析值时返回非0
+ * 对象结束或出错时返回0，正常结束时已经跳过右花括号
+ */
+static int object_member(cave_jsonc_parser ps, struct value_frame *frame) {
+	while(ps->in != '}') {
+		next(ps);
+		skip(ps);
+		if(ps->in == '}') {
+			if(frame->object->value.object->head) {
+				cave_jsonc_report_error(ps->doc, "多余的逗号", ps->pos, 1);
+				return 0;
+			} else
+				break;
+		}
+		cave_jsonc_position kp = ps->pos;
+		if(ps->in != '"') {
+			cave_jsonc_report_error(ps->doc, "键只能是字符串", ps->pos, 1);
+			return 0;
+		}
+		STAT_BEGIN(ps->stats);
+		cave_jsonc_string key = get_string(ps, 1);
+		STAT_END(ps->stats, string_ns);
+		if(!key)
+			return 0;
+		if(ps->in < 0) {
+			release_string(ps->doc, key);
+			cave_jsonc_report_error(ps->doc, "达到文件末尾对象键值对未定义完毕", ps->pos, 1);
+			return 0;
+		} else if(ps->in != ':') {
+			release_string(ps->doc, key);
+			cave_jsonc_report_error(ps->doc, "键值之间应当使用冒号分隔", ps->pos, 1);
+			return 0;
+		}
+		next(ps);
+		skip(ps);
+		if(cave_jsonc_has_fatal_error(ps->doc)) {
+			release_string(ps->doc, key);
+			cave_jsonc_report_error(ps->doc, "键值之间应当使用冒号分隔", ps->pos, 1);
+			return 0;
+		}
+		frame->key = key;
+		frame->key_position = kp;
+		return 1;
+	}
+	next(ps);
+	skip(ps);
+	return 0;
+}
+
+/**
+ * 把解析好的值放进对象，可以继续读取下一个键时返回非0
+ */
+static int object_value(cave_jsonc_parser ps, struct value_frame *frame, cave_jsonc_value value) {
+	cave_jsonc_string key = frame->key;
+	frame->key = NULL;
+	if(!value) {
+		release_string(ps->doc, key);
+		return 0;
+	}
+	cave_jsonc_kvpair pair = doc_alloc(ps->doc, sizeof(struct _cave_jsonc_kvpair));
+	pair->object = NULL;
+	pair->key = key;
+	pair->value = value;
+	pair->position = frame->key_position;
+	cave_jsonc_move_kvpair_to_object(pair, frame->object->value.object);
+	cave_jsonc_insert_last_kvpair(frame->object->value.object, pair);
+	if(cave_jsonc_has_fatal_error(ps->doc))
+		return 0;
+	if(ps->in < 0) {
+		cave_jsonc_report_error(ps->doc, "达到文件末尾对象花括号仍未配对", ps->pos, 1);
+		return 0;
+	} else if(ps->in != ',' && ps->in != '}') {
+		cave_jsonc_report_error(ps->doc, "相邻键值对之间应当使用逗号分隔", ps->pos, 1);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * 移到数组的下一个元素，需要解析元素时返回非0，数组结束时返回0
+ */
+static int array_element(cave_jsonc_parser ps, struct value_frame *frame) {
+	if(ps->in == ']')
+		return 0;
+	next(ps);
+	skip(ps);
+	return ps->in != ']' || frame->length;// 空数组
+}
+
+/**
+ * 把解析好的元素放进数组，可以继续读取下一个元素时返回非0
+ */
+static int array_value(cave_jsonc_parser ps, struct value_frame *frame, cave_jsonc_value value) {
+	if(value) {
+		if(frame->length == frame->cap) {
+			frame->cap *= 2;
+			STAT_ALLOC(ps->stats, sizeof(cave_jsonc_value) * frame->cap);
+			frame->values = realloc(frame->values, sizeof(cave_jsonc_value) * frame->cap);
+		}
+		frame->values[frame->length++] = value;
+	}
+	if(cave_jsonc_has_fatal_error(ps->doc))
+		return 0;
+	if(ps->in != ',' && ps->in != ']') {
+		cave_jsonc_report_error(ps->doc, "数组中相邻键之间应当使用逗号分隔", ps->pos, 1);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * 在显式的栈上迭代解析一个值，嵌套深度不受调用栈大小的限制
+ * 出错时保留已经解析的部分，语法和错误信息与递归实现一致
+ */
+static cave_jsonc_value parse_value(cave_jsonc_parser ps) {
+	size_t base = ps->depth;
+	for(;;) {
+		// 读取一个值的开头，容器入栈后读取它的第一个成员
+		cave_jsonc_position p = ps->pos;
+		cave_jsonc_value value;
+		if(ps->in == '{' || ps->in == '[') {
+			if(check_depth(ps, ps->depth - base)) {
+				value = NULL;
+			} else if(ps->lazy && ps->depth > base && (value = skim_container(ps))) {
+				// 跳过的容器在第一次访问时解析
+				STAT_ADD(ps->stats, nodes[value->type], 1);
+			} else if(ps->in == '{') {
+				STAT_ADD(ps->stats, nodes[CAVE_JSONC_OBJECT], 1);
+				cave_jsonc_value object = cave_jsonc_create_object_value(ps->doc);
+				cave_jsonc_set_value_position(object, p);
+				struct value_frame *frame = push_value_frame(ps, p);
+				frame->object = object;
+				if(object_member(ps, frame))
+					continue;
+				ps->depth--;
+				value = object;
+			} else {
+				STAT_ADD(ps->stats, nodes[CAVE_JSONC_ARRAY], 1);
+				struct value_frame *frame = push_value_frame(ps, p);
+				frame->cap = 32;
+				STAT_ALLOC(ps->stats, sizeof(cave_jsonc_value) * frame->cap);
+				frame->values = malloc(sizeof(cave_jsonc_value) * frame->cap);
+				if(array_element(ps, frame))
+					continue;
+				next(ps);
+				skip(ps);
+				ps->depth--;
+				value = make_array(ps->doc, frame->values, frame->length, p);
+			}
+		} else
+			value = parse_scalar(ps);
+		// 一个值结束，放进上一层容器，上一层也结束时继续向外
+		for(;;) {
+			if(ps->depth == base)
+				return value;
+			struct value_frame *frame = &ps->frames[ps->depth - 1];
+			if(frame->object) {
+				if(object_value(ps, frame, value) && object_member(ps, frame))
+					break;
+				ps->depth--;
+				value = frame->object;
+			} else {
+				if(array_value(ps, frame, value) && array_element(ps, frame))
+					break;
+				next(ps);
+				skip(ps);
+				ps->depth--;
+				value = make_array(ps->doc, frame->values, frame->length, frame->position);
+			}
+		}
+	}
+}
+
+cave_jsonc_parser cave_jsonc_create_parser(void) {
+	return calloc(1, sizeof(struct _cave_jsonc_parser));
+}
+
+/**
+ * 释放解析器的暂存区，解析器本身可以继续使用
+ */
+static void release_scratch(cave_jsonc_parser ps) {
+	free(ps->buf);
+	free(ps->frames);
+	free(ps->sax_frames);
+	ps->buf = NULL;
+	ps->frames = NULL;
+	ps->sax_frames = NULL;
+	ps->frames_cap = ps->sax_cap = 0;
+}
+
+void cave_jsonc_release_parser(cave_jsonc_parser ps) {
+	release_scratch(ps);
+	cave_jsonc_release_intern(ps->intern);
+	free(ps);
+}
+
+void cave_jsonc_parser_set_max_depth(cave_jsonc_parser ps, size_t depth) {
+	ps->max_depth = depth;
+}
+
+void cave_jsonc_parser_set_intern(cave_jsonc_parser ps, cave_jsonc_intern intern) {
+	if(intern)
+		intern->references++;
+	cave_jsonc_release_intern(ps->intern);
+	ps->intern = intern;
+}
+
+void cave_jsonc_parser_set_stats(cave_jsonc_parser ps, cave_jsonc_stats *stats) {
+#ifdef CAVE_JSONC_STATS
+	ps->stats = stats;
+#else
+	(void) ps;
+	(void) stats;
+#endif
+}
+
+#ifdef CAVE_JSONC_STATS
+/**
+ * 已经计入各阶段的耗时，总耗时减去它们的增量就是结构部分的耗时
+ */
+static uint64_t stat_phases(const cave_jsonc_stats *stats) {
+	return stats->skip_ns + stats->string_ns + stats->number_ns;
+}
+#endif
+
+/**
+ * 解析一个延迟解析的容器的直属成员，嵌套的容器仍然延迟解析
+ * 容器中的错误在这时才报告到文档中，之前的致命错误不影响这次解析
+ */
+static void materialize(cave_jsonc_value value) {
+	cave_jsonc_document doc = value->document;
+	const unsigned char *source = (const unsigned char *) doc->source;
+	struct _cave_jsonc_parser ps = {0};
+	ps.doc = doc;
+	ps.lazy = 1;
+	ps.max_depth = value->value.lazy.max_depth;
+	ps.src = source + value->position.index;
+	ps.src_end = source + value->value.lazy.end + 1;
+	ps.in = ps.src[-1];
+	ps.pos = value->position;
+	int fatal = doc->fatal;
+	doc->fatal = 0;
+	cave_jsonc_value parsed = parse_value(&ps);
+	doc->fatal |= fatal;
+	release_scratch(&ps);
+	// 解析出的容器移到原来的值上，再释放新建的值
+	value->value = parsed->value;
+	if(value->type == CAVE_JSONC_OBJECT)
+		value->value.object->value = value;
+	parsed->type = CAVE_JSONC_NULL;
+	cave_jsonc_release_value(parsed);
+}
+
+static void stream_input(cave_jsonc_parser ps, int (*fgetc)(void *file), void *file) {
+	ps->ffgetc = fgetc;
+	ps->ffile = file;
+	ps->src = ps->src_end = NULL;
+}
+
+static void buffer_input(cave_jsonc_parser ps, const char *data, size_t length) {
+	ps->ffgetc = NULL;
+	ps->ffile = NULL;
+	ps->src = (const unsigned char *) data;
+	ps->src_end = ps->src + length;
+}
+
+static cave_jsonc_document parse_root(cave_jsonc_parser ps, int flags) {
+	ps->pos = (cave_jsonc_position) {1, 1, 0};
+	ps->in = 0;
+	ps->doc = cave_jsonc_create_document_with_flags(flags);
+#ifdef CAVE_JSONC_STATS
+	ps->doc->stats = ps->stats;
+	uint64_t stat_start = ps->stats ? stat_clock() : 0, stat_before = ps->stats ? stat_phases(ps->stats) : 0;
+#endif
+	if(flags & CAVE_JSONC_DOCUMENT_INTERN) {
+		if(ps->intern)
+			ps->intern->references++;
+		ps->doc->intern = ps->intern ? ps->intern : cave_jsonc_create_intern();
+	}
+	if((flags & CAVE_JSONC_DOCUMENT_LAZY) && !ps->ffgetc) {
+		ps->lazy = 1;
+		ps->doc->source = (const char *) ps->src;
+		ps->doc->source_length = ps->src_end - ps->src;
+	}
+	next(ps);
+	skip(ps);
+	cave_jsonc_set_document_root(ps->doc, parse_value(ps));
+	if(!cave_jsonc_has_fatal_error(ps->doc) && ps->in > 0)
+		cave_jsonc_report_error(ps->doc, "解析完毕后文本仍有内容", ps->pos, 1);
+#ifdef CAVE_JSONC_STATS
+	if(ps->stats) {
+		ps->stats->bytes += ps->pos.index - (ps->in < 0);
+		ps->stats->structure_ns += stat_clock() - stat_start - (stat_phases(ps->stats) - stat_before);
+	}
+	ps->doc->stats = NULL;
+#endif
+	cave_jsonc_document doc = ps->doc;
+	ps->doc = NULL;
+	ps->lazy = 0;
+	ps->src = ps->src_end = NULL;
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parser_parse_document(cave_jsonc_parser ps,
+		int (*fgetc)(void *file), void *file, int flags) {
+	stream_input(ps, fgetc, file);
+	return parse_root(ps, flags);
+}
+
+cave_jsonc_document cave_jsonc_parser_parse_buffer(cave_jsonc_parser ps, const char *data, size_t length, int flags) {
+	buffer_input(ps, data, length);
+	return parse_root(ps, flags);
+}
+
+/**
+ * 只读映射整个文件，失败时返回保存错误的文档
+ */
+static cave_jsonc_document map_file(const char *path, int flags, void **mapping, size_t *length) {
+	int fd = open(path, O_RDONLY);
+	struct stat st;
+	if(fd < 0 || fstat(fd, &st) < 0) {
+		if(fd >= 0)
+			close(fd);
+		cave_jsonc_document doc = cave_jsonc_create_document_with_flags(flags);
+		cave_jsonc_report_error(doc, "无法打开文件", (cave_jsonc_position) {-1, -1, -1}, 1);
+		return doc;
+	}
+	*length = st.st_size;
+	*mapping = *length ? mmap(NULL, *length, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+	close(fd);
+	if(*mapping == MAP_FAILED) {
+		cave_jsonc_document doc = cave_jsonc_create_document_with_flags(flags);
+		cave_jsonc_report_error(doc, "无法映射文件", (cave_jsonc_position) {-1, -1, -1}, 1);
+		return doc;
+	}
+	if(*mapping)
+		madvise(*mapping, *length, MADV_SEQUENTIAL);
+	return NULL;
+}
+
+/**
+ * 解析完映射的文件后，借用的字符串和延迟解析的容器指向映射，映射随文档释放，否则立即解除映射
+ */
+static cave_jsonc_document release_mapping(cave_jsonc_document doc, void *mapping, size_t length) {
+	if(mapping && (doc->flags & (CAVE_JSONC_DOCUMENT_BORROW | CAVE_JSONC_DOCUMENT_LAZY))) {
+		doc->mapping = mapping;
+		doc->mapping_length = length;
+	} else if(mapping)
+		munmap(mapping, length);
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parser_parse_file(cave_jsonc_parser ps, const char *path, int flags) {
+	void *mapping;
+	size_t length;
+	cave_jsonc_document doc = map_file(path, flags, &mapping, &length);
+	if(doc)
+		return doc;
+	return release_mapping(cave_jsonc_parser_parse_buffer(ps, mapping, length, flags), mapping, length);
+}
+
+/**
+ * 以下不带解析器的接口使用栈上的临时解析器，暂存区在解析结束时释放
+ */
+cave_jsonc_document cave_jsonc_parse_document(int (*fgetc)(void *file), void *file) {
+	return cave_jsonc_parse_document_with_flags(fgetc, file, 0);
+}
+
+cave_jsonc_document cave_jsonc_parse_document_with_flags(int (*fgetc)(void *file), void *file, int flags) {
+	struct _cave_jsonc_parser ps = {0};
+	cave_jsonc_document doc = cave_jsonc_parser_parse_document(&ps, fgetc, file, flags);
+	release_scratch(&ps);
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parse_buffer(const char *data, size_t length, int flags) {
+	struct _cave_jsonc_parser ps = {0};
+	cave_jsonc_document doc = cave_jsonc_parser_parse_buffer(&ps, data, length, flags);
+	release_scratch(&ps);
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parse_file(const char *path, int flags) {
+	struct _cave_jsonc_parser ps = {0};
+	cave_jsonc_document doc = cave_jsonc_parser_parse_file(&ps, path, flags);
+	release_scratch(&ps);
+	return doc;
+}
+
+/**
+ * 匹配括号用的内核：找到下一个字符串外需要处理的字节
+ * 包括括号、引号、可能开始注释的斜杠和separator，不关心逗号时separator传入引号
+ */
+typedef const unsigned char *(*structural_kernel)(const unsigned char *p, const unsigned char *end, unsigned char separator);
+
+static inline int is_structural(unsigned char c, unsigned char separator) {
+	return c == '"' || c == '/' || c == separator || (c | 0x20) == '{' || (c | 0x20) == '}';
+}
+
+static const unsigned char *find_structural_scalar(const unsigned char *p, const unsigned char *end, unsigned char separator) {
+	while(p < end && !is_structural(*p, separator))
+		p++;
+	return p;
+}
+
+#ifdef CAVE_JSONC_X86_SIMD
+/**
+ * '['和'{'、']'和'}'只差0x20这一位，或上0x20后各用一次比较
+ */
+__attribute__((target("sse2")))
+static const unsigned char *find_structural_sse2(const unsigned char *p, const unsigned char *end, unsigned char separator) {
+	const __m128i quote = _mm_set1_epi8('"'), slash = _mm_set1_epi8('/'), comma = _mm_set1_epi8(separator),
+		  open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}'), lower = _mm_set1_epi8(0x20);
+	for(; end - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) p), folded = _mm_or_si128(v, lower);
+		__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash)),
+				_mm_or_si128(_mm_cmpeq_epi8(v, comma),
+					_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close))));
+		unsigned mask = _mm_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_structural_scalar(p, end, separator);
+}
+
+__attribute__((target("avx2")))
+static const unsigned char *find_structural_avx2(const unsigned char *p, const unsigned char *end, unsigned char separator) {
+	const __m256i quote = _mm256_set1_epi8('"'), slash = _mm256_set1_epi8('/'), comma = _mm256_set1_epi8(separator),
+		  open = _mm256_set1_epi8('{'), close = _mm256_set1_epi8('}'), lower = _mm256_set1_epi8(0x20);
+	for(; end - p >= 32; p += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) p), folded = _mm256_or_si256(v, lower);
+		__m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, slash)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, comma),
+					_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close))));
+		unsigned mask = _mm256_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_structural_sse2(p, end, separator);
+}
+#endif
+
+static const unsigned char *find_structural_dispatch(const unsigned char *p, const unsigned char *end, unsigned char separator);
+static structural_kernel find_structural = find_structural_dispatch;
+
+static const unsigned char *find_structural_dispatch(const unsigned char *p, const unsigned char *end, unsigned char separator) {
+	structural_kernel kernel = find_structural_scalar;
+#ifdef CAVE_JSONC_X86_SIMD
+	int level = simd_level();
+	if(level == SIMD_AVX2)
+		kernel = find_structural_avx2;
+	else if(level == SIMD_SSE2)
+		kernel = find_structural_sse2;
+#endif
+	__atomic_store_n(&find_structural, kernel, __ATOMIC_RELAXED);
+	return kernel(p, end, separator);
+}
+
+/**
+ * 第一阶段的结果：根容器的左括号、分隔根容器成员的逗号和右括号的偏移
+ * 相邻两个偏移之间是根容器的一个成员
+ */
+struct structural_index {
+	size_t *offsets;
+	size_t count, cap;
+};
+
+static void put_offset(struct structural_index *index, size_t offset) {
+	if(index->count == index->cap) {
+		index->cap = index->cap ? index->cap * 2 : 1024;
+		index->offsets = realloc(index->offsets, sizeof(size_t) * index->cap);
+	}
+	index->offsets[index->count++] = offset;
+}
+
+/**
+ * 从容器的左括号开始找到每一个结构字符，跳过字符串和注释，返回配对的右括号
+ * index不为NULL时记录容器的左括号、直属的逗号和右括号，这是并行解析的第一阶段
+ * 注释的规则与skip()一致，只有紧跟在空白之后的斜杠才开始注释
+ * 遇到任何需要报告错误的内容都返回NULL，交给完整的解析处理
+ */
+static const unsigned char *match_bracket(const unsigned char *data, size_t length, size_t open, struct structural_index *index) {
+	const unsigned char *p = data + open + 1, *end = data + length;
+	size_t depth = 1;
+	// 不需要记录逗号时让内核只在引号处停下
+	unsigned char comma = index ? ',' : '"';
+	if(index)
+		put_offset(index, open);
+	while((p = SIMD_KERNEL(find_structural)(p, end, comma)) < end) {
+		switch(*p) {
+			case '"':
+				for(p++; ; p += *p == '\\' ? 2 : 1) {
+					p = SIMD_KERNEL(find_string_special)(p, end);
+					if(p >= end || *p == '\n')
+						return NULL;
+					if(*p == '"')
+						break;
+				}
+				p++;
+				break;
+			case '/':
+				if(!is_space(p[-1]) || end - p < 2) {
+					return NULL;
+				} else if(p[1] == '/') {
+					if(!(p = memchr(p, '\n', end - p)))
+						return NULL;
+				} else if(p[1] == '*') {
+					const unsigned char *star = p + 2;
+					while((star = memchr(star, '*', end - star)) && star + 1 < end && star[1] != '/')
+						star++;
+					if(!star || star + 1 >= end)
+						return NULL;
+					p = star + 2;
+				} else
+					return NULL;
+				break;
+			case ',':
+				if(index && depth == 1)
+					put_offset(index, p - data);
+				p++;
+				break;
+			case '{':
+			case '[':
+				depth++;
+				p++;
+				break;
+			default:
+				if(!--depth) {
+					// 容器自己的括号必须配对，内部的括号由完整的解析检查
+					if((*p == '}') != (data[open] == '{'))
+						return NULL;
+					if(index)
+						put_offset(index, p - data);
+					return p;
+				}
+				p++;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * 按偏移递增的顺序求出字符的位置，结果与next()读到这个字符时一致
+ */
+struct line_counter {
+	const unsigned char *data, *scanned, *last;
+	ssize_t row;
+};
+
+static cave_jsonc_position line_position(struct line_counter *lines, size_t offset) {
+	const unsigned char *p = lines->data + offset;
+	lines->row += count_lines(lines->scanned, p, &lines->last);
+	lines->scanned = p;
+	return (cave_jsonc_position) {lines->row, lines->last ? p - lines->last + 1 : (ssize_t) offset + 2, offset + 1};
+}
+
+/**
+ * 第二阶段的一个工作线程：解析根容器中第first到last-1个成员
+ * 解析到的内容放在自己的文档中，成功后把值的文档改为目标文档
+ */
+struct parse_worker {
+	const unsigned char *data, *end;
+	const size_t *offsets;
+	size_t first, last;
+	cave_jsonc_position position;
+	int flags, object;
+	cave_jsonc_document target, doc;
+	/**
+	 * 数组的元素或对象的键值对
+	 */
+	void **members;
+	size_t size;
+	/**
+	 * 非arena模式下文档中所有值的链表的首尾
+	 */
+	cave_jsonc_value head, tail;
+	int failed;
+};
+
+/**
+ * 解析对象中从键开始的一个键值对，出错时返回NULL，错误信息由顺序解析重新报告
+ */
+static cave_jsonc_kvpair parse_member(cave_jsonc_parser ps) {
+	cave_jsonc_position kp = ps->pos;
+	if(ps->in != '"')
+		return NULL;
+	cave_jsonc_string key = get_string(ps, 1);
+	if(!key)
+		return NULL;
+	if(ps->in != ':') {
+		release_string(ps->doc, key);
+		return NULL;
+	}
+	next(ps);
+	skip(ps);
+	cave_jsonc_value value = cave_jsonc_has_fatal_error(ps->doc) ? NULL : parse_value(ps);
+	if(!value) {
+		release_string(ps->doc, key);
+		return NULL;
+	}
+	cave_jsonc_kvpair pair = doc_alloc(ps->doc, sizeof(struct _cave_jsonc_kvpair));
+	pair->object = NULL;
+	pair->key = key;
+	pair->value = value;
+	pair->position = kp;
+	return pair;
+}
+
+/**
+ * 把一个成员中所有值的文档改为目标文档，arena模式下值不在链表上，只能遍历树
+ */
+static void adopt_tree(cave_jsonc_value value, cave_jsonc_document target, struct value_frame **stack, size_t *cap) {
+	size_t depth = 0;
+	for(;;) {
+		value->document = target;
+		if(value->type == CAVE_JSONC_OBJECT || value->type == CAVE_JSONC_ARRAY) {
+			if(depth == *cap) {
+				*cap = *cap ? *cap * 2 : 16;
+				*stack = realloc(*stack, sizeof(struct value_frame) * *cap);
+			}
+			struct value_frame *frame = &(*stack)[depth++];
+			frame->object = value;
+			frame->key = NULL;
+			frame->length = 0;
+			if(value->type == CAVE_JSONC_OBJECT)
+				frame->key_position.index = 0;
+		}
+		value = NULL;
+		while(depth && !value) {
+			struct value_frame *frame = &(*stack)[depth - 1];
+			cave_jsonc_value container = frame->object;
+			if(container->type == CAVE_JSONC_ARRAY) {
+				if(frame->length < container->value.array->length)
+					value = container->value.array->values[frame->length++];
+			} else {
+				// 对象用values记录下一个键值对
+				cave_jsonc_kvpair pair = frame->length++ ? (cave_jsonc_kvpair) frame->values :
+					container->value.object->head;
+				if(pair) {
+					value = pair->value;
+					frame->values = (cave_jsonc_value *) pair->next;
+				}
+			}
+			if(!value)
+				depth--;
+		}
+		if(!value)
+			return;
+	}
+}
+
+static void *parse_range(void *arg) {
+	struct parse_worker *w = arg;
+	struct _cave_jsonc_parser ps = {0};
+	w->doc = ps.doc = cave_jsonc_create_document_with_flags(w->flags);
+	ps.src = w->data + w->offsets[w->first] + 1;
+	ps.src_end = w->end;
+	ps.in = ps.src[-1];
+	ps.pos = w->position;
+	w->members = malloc(sizeof(void *) * (w->last - w->first));
+	w->size = 0;
+	for(size_t i = w->first; i < w->last && !w->failed; i++) {
+		next(&ps);
+		skip(&ps);
+		void *member = w->object ? (void *) parse_member(&ps) : (void *) parse_value(&ps);
+		if(member)
+			w->members[w->size++] = member;
+		// 成员必须恰好结束在第一阶段找到的下一个分隔符上
+		const unsigned char *separator = w->data + w->offsets[i + 1];
+		if(!member || cave_jsonc_has_fatal_error(ps.doc) || ps.src - 1 != separator || ps.in != *separator)
+			w->failed = 1;
+	}
+	if(!w->failed) {
+		if(is_arena(w->doc)) {
+			for(size_t i = 0; i < w->size; i++)
+				adopt_tree(w->object ? ((cave_jsonc_kvpair) w->members[i])->value : w->members[i],
+						w->target, &ps.frames, &ps.frames_cap);
+		} else {
+			w->head = w->doc->all_allocated;
+			for(cave_jsonc_value value = w->head; value; value = value->next) {
+				value->document = w->target;
+				w->tail = value;
+			}
+			w->doc->all_allocated = NULL;
+		}
+	}
+	release_scratch(&ps);
+	return NULL;
+}
+
+/**
+ * 把工作线程的内存交给目标文档
+ */
+static void merge_worker(cave_jsonc_document target, struct parse_worker *w) {
+	if(is_arena(target)) {
+		struct _cave_jsonc_arena *chunk = w->doc->arena;
+		if(chunk) {
+			struct _cave_jsonc_arena *tail = chunk;
+			while(tail->next)
+				tail = tail->next;
+			// 接在当前块之后，不影响当前块继续分配
+			if(target->arena) {
+				tail->next = target->arena->next;
+				target->arena->next = chunk;
+			} else
+				target->arena = chunk;
+			w->doc->arena = NULL;
+		}
+	} else if(w->head) {
+		w->tail->next = target->all_allocated;
+		if(target->all_allocated)
+			target->all_allocated->prev = w->tail;
+		target->all_allocated = w->head;
+	}
+}
+
+static void discard_worker(struct parse_worker *w) {
+	if(!w->doc)
+		return;
+	if(!w->failed && !is_arena(w->doc)) {
+		// 值已经改为属于目标文档，先放回自己的文档再释放
+		for(cave_jsonc_value value = w->head; value; value = value->next)
+			value->document = w->doc;
+		w->doc->all_allocated = w->head;
+	}
+	// 还没有放进对象的键值对不会随值释放
+	for(size_t i = 0; w->object && i < w->size; i++) {
+		cave_jsonc_kvpair pair = w->members[i];
+		release_string(w->doc, pair->key);
+		doc_free(w->doc, pair);
+	}
+	cave_jsonc_release_all_nodes_in_document(w->doc);
+	cave_jsonc_release_document(w->doc);
+	free(w->members);
+}
+
+/**
+ * 在count个线程上运行routine，第i个线程的参数是args中的第i项，第0项在调用线程中运行
+ * 无法创建线程时在调用线程中依次运行
+ */
+static void run_workers(void *(*routine)(void *), void *args, size_t size, size_t count) {
+#ifndef CAVE_JSONC_NO_THREADS
+	pthread_t *tids = malloc(sizeof(pthread_t) * count);
+	int *started = calloc(count, sizeof(int));
+	for(size_t i = 1; i < count; i++)
+		started[i] = !pthread_create(&tids[i], NULL, routine, (char *) args + size * i);
+	routine(args);
+	for(size_t i = 1; i < count; i++)
+		if(started[i])
+			pthread_join(tids[i], NULL);
+		else
+			routine((char *) args + size * i);
+	free(tids);
+	free(started);
+#else
+	for(size_t i = 0; i < count; i++)
+		routine((char *) args + size * i);
+#endif
+}
+
+/**
+ * 每个工作线程至少分到的字节数，更小的文档直接顺序解析
+ */
+#define PARALLEL_MIN_CHUNK ((size_t) 256 << 10)
+
+/**
+ * threads<=0时使用所有CPU，再按输入的大小减少线程数
+ */
+static size_t worker_count(int threads, size_t length) {
+	size_t count = threads > 0 ? threads : sysconf(_SC_NPROCESSORS_ONLN);
+	return count > length / PARALLEL_MIN_CHUNK ? length / PARALLEL_MIN_CHUNK : count;
+}
+
+/**
+ * 根容器之前的空白和注释由顺序解析器跳过，之后第一阶段建立根容器的结构索引
+ * 第二阶段按字节数把根容器的成员平均分给各个线程，最后按顺序合并到一个文档中
+ * 任何一个线程出错都丢弃并行的结果，重新顺序解析，错误信息与顺序解析完全一致
+ */
+static cave_jsonc_document parse_buffer_parallel(const char *data, size_t length, int flags, int threads) {
+	struct _cave_jsonc_parser ps = {0};
+	buffer_input(&ps, data, length);
+	ps.pos = (cave_jsonc_position) {1, 1, 0};
+	ps.doc = cave_jsonc_create_document_with_flags(flags);
+	next(&ps);
+	skip(&ps);
+	size_t open = ps.src - 1 - (const unsigned char *) data;
+	struct structural_index index = {0};
+	size_t count = worker_count(threads, length);
+	if(count < 2 || (flags & (CAVE_JSONC_DOCUMENT_LAZY | CAVE_JSONC_DOCUMENT_INTERN)) ||
+			cave_jsonc_has_fatal_error(ps.doc) || (ps.in != '{' && ps.in != '[') ||
+			!match_bracket(ps.src - 1 - open, length, open, &index) || index.count - 1 < count) {
+		free(index.offsets);
+		cave_jsonc_release_document(ps.doc);
+		return cave_jsonc_parse_buffer(data, length, flags);
+	}
+	struct parse_worker *workers = calloc(count, sizeof(struct parse_worker));
+	struct line_counter lines = {ps.src - 1 - open, ps.src - 1 - open, NULL, 1};
+	size_t members = index.count - 1, span = index.offsets[members] - open, first = 0;
+	for(size_t i = 0; i < count; i++) {
+		struct parse_worker *w = &workers[i];
+		// 第i个线程的范围结束在第一个超过(i+1)/count的分隔符
+		size_t limit = open + span / count * (i + 1), last = first + 1;
+		while(last < members && (i == count - 1 || index.offsets[last] < limit) && members - last > count - 1 - i)
+			last++;
+		w->data = lines.data;
+		w->end = lines.data + length;
+		w->offsets = index.offsets;
+		w->first = first;
+		w->last = i == count - 1 ? members : last;
+		w->position = line_position(&lines, index.offsets[first]);
+		w->flags = flags;
+		w->object = ps.in == '{';
+		w->target = ps.doc;
+		first = w->last;
+	}
+	run_workers(parse_range, workers, sizeof(struct parse_worker), count);
+	int failed = 0;
+	for(size_t i = 0; i < count; i++)
+		failed |= workers[i].failed;
+	if(failed) {
+		for(size_t i = 0; i < count; i++)
+			discard_worker(&workers[i]);
+		free(workers);
+		free(index.offsets);
+		cave_jsonc_release_document(ps.doc);
+		return cave_jsonc_parse_buffer(data, length, flags);
+	}
+	// 按顺序合并各个线程的成员
+	// 第一个线程从根容器的左括号开始
+	cave_jsonc_position p = workers[0].position;
+	cave_jsonc_value root = NULL;
+	if(ps.in == '{') {
+		root = cave_jsonc_create_object_value(ps.doc);
+		cave_jsonc_set_value_position(root, p);
+	}
+	cave_jsonc_value *values = ps.in == '[' ? malloc(sizeof(cave_jsonc_value) * members) : NULL;
+	size_t size = 0;
+	for(size_t i = 0; i < count; i++) {
+		struct parse_worker *w = &workers[i];
+		merge_worker(ps.doc, w);
+		for(size_t j = 0; j < w->size; j++)
+			if(values) {
+				values[size++] = w->members[j];
+			} else {
+				cave_jsonc_move_kvpair_to_object(w->members[j], root->value.object);
+				cave_jsonc_insert_last_kvpair(root->value.object, w->members[j]);
+			}
+		free(w->members);
+		cave_jsonc_release_document(w->doc);
+	}
+	if(values)
+		root = make_array(ps.doc, values, size, p);
+	cave_jsonc_set_document_root(ps.doc, root);
+	// 从根容器的右括号继续，与顺序解析一样检查之后的内容
+	size_t close = index.offsets[members];
+	ps.src = lines.data + close + 1;
+	ps.in = lines.data[close];
+	ps.pos = line_position(&lines, close);
+	next(&ps);
+	skip(&ps);
+	if(!cave_jsonc_has_fatal_error(ps.doc) && ps.in > 0)
+		cave_jsonc_report_error(ps.doc, "解析完毕后文本仍有内容", ps.pos, 1);
+	free(workers);
+	free(index.offsets);
+	release_scratch(&ps);
+	return ps.doc;
+}
+
+cave_jsonc_document cave_jsonc_parse_buffer_parallel(const char *data, size_t length, int flags, int threads) {
+	return parse_buffer_parallel(data, length, flags, threads);
+}
+
+cave_jsonc_document cave_jsonc_parse_file_parallel(const char *path, int flags, int threads) {
+	void *mapping;
+	size_t length;
+	cave_jsonc_document doc = map_file(path, flags, &mapping, &length);
+	if(doc)
+		return doc;
+	if(mapping)
+		madvise(mapping, length, MADV_WILLNEED);
+	return release_mapping(parse_buffer_parallel(mapping, length, flags, threads), mapping, length);
+}
+
+/**
+ * 一批按行分隔的记录的解析结果
+ */
+struct _cave_jsonc_batch {
+	/**
+	 * 每条记录的文档和所在的行号
+	 */
+	cave_jsonc_document *documents;
+	size_t *lines;
+	size_t length;
+	/**
+	 * 无法读取输入等与单条记录无关的错误
+	 */
+	cave_jsonc_document error;
+	/**
+	 * 借用和延迟解析模式下文档指向文件的映射，映射随结果释放
+	 */
+	void *mapping;
+	size_t mapping_length;
+};
+
+/**
+ * 解析一批记录的工作线程，每个线程用同一个解析器依次解析分到的记录
+ */
+struct batch_worker {
+	const char *data;
+	const size_t *starts, *ends;
+	size_t first, last;
+	int flags;
+	cave_jsonc_document *documents;
+	const cave_jsonc_sax_handler *handler;
+	void *(*record)(void *user, size_t index);
+	void *user;
+};
+
+static void *parse_records(void *arg) {
+	struct batch_worker *w = arg;
+	struct _cave_jsonc_parser ps = {0};
+	// 驻留表不能在线程间共用，同一个线程解析的记录共用一个
+	if(w->flags & CAVE_JSONC_DOCUMENT_INTERN)
+		ps.intern = cave_jsonc_create_intern();
+	for(size_t i = w->first; i < w->last; i++) {
+		const char *data = w->data + w->starts[i];
+		size_t length = w->ends[i] - w->starts[i];
+		if(w->handler)
+			w->documents[i] = cave_jsonc_parser_parse_buffer_events(&ps, data, length, w->handler,
+					w->record ? w->record(w->user, i) : w->user);
+		else
+			w->documents[i] = cave_jsonc_parser_parse_buffer(&ps, data, length, w->flags);
+	}
+	release_scratch(&ps);
+	cave_jsonc_release_intern(ps.intern);
+	return NULL;
+}
+
+/**
+ * 按换行切分记录，跳过只有空白的行，各段记录的字节数大致相同地分给各个线程
+ * 记录中的位置从记录开头算起，记录所在的行号另外保存
+ */
+static cave_jsonc_batch parse_batch(const char *data, size_t length, int flags, int threads,
+		const cave_jsonc_sax_handler *handler, void *(*record)(void *user, size_t index), void *user) {
+	cave_jsonc_batch batch = calloc(1, sizeof(struct _cave_jsonc_batch));
+	size_t *starts = NULL, *ends = NULL, cap = 0, line = 0;
+	for(const char *p = data, *end = data + length; p < end; ) {
+		const char *eol = memchr(p, '\n', end - p);
+		if(!eol)
+			eol = end;
+		line++;
+		const char *q = p;
+		while(q < eol && (*q == ' ' || *q == '\t' || *q == '\r'))
+			q++;
+		if(q < eol) {
+			if(batch->length == cap) {
+				cap = cap ? cap * 2 : 256;
+				starts = realloc(starts, sizeof(size_t) * cap);
+				ends = realloc(ends, sizeof(size_t) * cap);
+				batch->lines = realloc(batch->lines, sizeof(size_t) * cap);
+			}
+			starts[batch->length] = p - data;
+			ends[batch->length] = eol - data;
+			batch->lines[batch->length++] = line;
+		}
+		p = eol + 1;
+	}
+	batch->documents = malloc(sizeof(cave_jsonc_document) * (batch->length ? batch->length : 1));
+	size_t count = worker_count(threads, length);
+	if(count > batch->length)
+		count = batch->length;
+	if(count < 1)
+		count = 1;
+	struct batch_worker *workers = malloc(sizeof(struct batch_worker) * count);
+	for(size_t i = 0, first = 0; i < count; i++) {
+		// 第i个线程的范围结束在第一个越过(i+1)/count的记录，并给后面的线程各留至少一条记录
+		size_t limit = length / count * (i + 1), last = first;
+		while(last < batch->length && (i == count - 1 || (starts[last] < limit && batch->length - last > count - 1 - i)))
+			last++;
+		workers[i] = (struct batch_worker) {data, starts, ends, first, last, flags, batch->documents, handler, record, user};
+		first = last;
+	}
+	run_workers(parse_records, workers, sizeof(struct batch_worker), count);
+	free(workers);
+	free(starts);
+	free(ends);
+	return batch;
+}
+
+cave_jsonc_batch cave_jsonc_parse_batch_buffer(const char *data, size_t length, int flags, int threads) {
+	return parse_batch(data, length, flags, threads, NULL, NULL, NULL);
+}
+
+cave_jsonc_batch cave_jsonc_parse_batch_file(const char *path, int flags, int threads) {
+	void *mapping;
+	size_t length;
+	cave_jsonc_document doc = map_file(path, flags, &mapping, &length);
+	if(doc) {
+		cave_jsonc_batch batch = calloc(1, sizeof(struct _cave_jsonc_batch));
+		batch->error = doc;
+		return batch;
+	}
+	if(mapping)
+		madvise(mapping, length, MADV_WILLNEED);
+	cave_jsonc_batch batch = parse_batch(mapping, length, flags, threads, NULL, NULL, NULL);
+	if(mapping && (flags & (CAVE_JSONC_DOCUMENT_BORROW | CAVE_JSONC_DOCUMENT_LAZY))) {
+		batch->mapping = mapping;
+		batch->mapping_length = length;
+	} else if(mapping)
+		munmap(mapping, length);
+	return batch;
+}
+
+cave_jsonc_batch cave_jsonc_parse_batch_events(const char *data, size_t length, const cave_jsonc_sax_handler *handler,
+		void *(*record)(void *user, size_t index), void *user, int threads) {
+	return parse_batch(data, length, 0, threads, handler, record, user);
+}
+
+size_t cave_jsonc_get_batch_length(cave_jsonc_batch batch) {
+	return batch->length;
+}
+
+cave_jsonc_document cave_jsonc_get_batch_document(cave_jsonc_batch batch, size_t index) {
+	return index < batch->length ? batch->documents[index] : NULL;
+}
+
+size_t cave_jsonc_get_batch_line(cave_jsonc_batch batch, size_t index) {
+	return index < batch->length ? batch->lines[index] : 0;
+}
+
+cave_jsonc_document cave_jsonc_get_batch_error(cave_jsonc_batch batch) {
+	return batch->error;
+}
+
+static void ffputs(int (*fputc)(int c, void *file), void *file, const char *str);
+
+/**
+ * 与cave_jsonc_print_error的格式相同，记录中的行号换算为输入中的行号
+ */
+int cave_jsonc_print_batch_error(cave_jsonc_batch batch, int (*fputc)(int c, void *file), void *file) {
+	if(batch->error)
+		return cave_jsonc_print_error(batch->error, fputc, file);
+	char head[100];
+	size_t count = 0;
+	for(size_t i = 0; i < batch->length; i++)
+		for(cave_jsonc_error err = batch->documents[i]->error_head; err; err = err->next) {
+			const char *level = err->fatal > 0 ? "错误" : err->fatal == 0 ? "警告" : "信息";
+			if(err->position.row > 0 && err->position.cols > 0)
+				sprintf(head, "%zu:%ld: %s: ", batch->lines[i] + err->position.row - 1, err->position.cols, level);
+			else
+				sprintf(head, "%zu: %s: ", batch->lines[i], level);
+			ffputs(fputc, file, head);
+			ffputs(fputc, file, err->message);
+			fputc('\n', file);
+			count += err->fatal >= 0;
+		}
+	if(count) {
+		sprintf(head, "共 %ld 个错误或警告\n", count);
+		ffputs(fputc, file, head);
+	}
+	return count;
+}
+
+void cave_jsonc_release_batch(cave_jsonc_batch batch) {
+	if(!batch)
+		return;
+	for(size_t i = 0; i < batch->length; i++) {
+		cave_jsonc_release_all_nodes_in_document(batch->documents[i]);
+		cave_jsonc_release_document(batch->documents[i]);
+	}
+	if(batch->error)
+		cave_jsonc_release_document(batch->error);
+	if(batch->mapping)
+		munmap(batch->mapping, batch->mapping_length);
+	free(batch->documents);
+	free(batch->lines);
+	free(batch);
+}
+
+/**
+ * 按事件解析不是容器的值，出错或回调要求停止时返回非0
+ */
+static int sax_scalar(cave_jsonc_parser ps) {
+	cave_jsonc_position p = ps->pos;
+	if(ps->in < 0) {
+		cave_jsonc_report_error(ps->doc, "意料之外的文件结束", ps->pos, 1);
+		return 1;
+	}
+	if(ps->in == 'n') {
+		if(!lex_literal(ps, "ull"))
+			return 1;
+		return ps->sax->null && ps->sax->null(ps->sax_user, p);
+	} else if(ps->in == 't') {
+		if(!lex_literal(ps, "rue"))
+			return 1;
+		return ps->sax->boolean && ps->sax->boolean(ps->sax_user, 1, p);
+	} else if(ps->in == 'f') {
+		if(!lex_literal(ps, "alse"))
+			return 1;
+		return ps->sax->boolean && ps->sax->boolean(ps->sax_user, 0, p);
+	} else if(ps->in == '"') {
+		const char *value;
+		size_t length;
+		if(!lex_string(ps, 1, &value, &length))
+			return 1;
+		return ps->sax->string && ps->sax->string(ps->sax_user, value, length, p);
+	} else if((ps->in >= '0' && ps->in <= '9') || ps->in == '-') {
+		struct number_text text;
+		struct _cave_jsonc_number num;
+		int integer;
+		if(!lex_number(ps, &text, &integer))
+			return 1;
+		num.flag = 0;
+		decode_number_text(&num, text.value, text.size - 1, integer);
+		cave_jsonc_sax_number number;
+		number.raw = text.value;
+		number.length = text.size - 1;
+		number.integer = (num.flag & CAVE_JSONC_NUM_IVAL) != 0;
+		number.ival = number.integer ? num.ival : 0;
+		number.fval = number.integer ? (double) num.ival : num.fval;
+		int stop = ps->sax->number && ps->sax->number(ps->sax_user, &number, p);
+		release_number_text(&text);
+		return stop;
+	} else {
+		cave_jsonc_report_error(ps->doc, "无法理解的内容", ps->pos, 1);
+		return 1;
+	}
+}
+
+/**
+ * 读取对象的下一个键直到冒号之后并发出键事件
+ * 需要解析值时返回1，对象正常结束时跳过右花括号并返回0，出错或回调要求停止时返回-1
+ */
+static int sax_member(cave_jsonc_parser ps, struct sax_frame *frame) {
+	while(ps->in != '}') {
+		next(ps);
+		skip(ps);
+		if(ps->in == '}') {
+			if(frame->count) {
+				cave_jsonc_report_error(ps->doc, "多余的逗号", ps->pos, 1);
+				return -1;
+			} else
+				break;
+		}
+		cave_jsonc_position kp = ps->pos;
+		if(ps->in != '"') {
+			cave_jsonc_report_error(ps->doc, "键只能是字符串", ps->pos, 1);
+			return -1;
+		}
+		const char *key;
+		size_t length;
+		if(!lex_string(ps, 1, &key, &length))
+			return -1;
+		if(ps->in < 0) {
+			cave_jsonc_report_error(ps->doc, "达到文件末尾对象键值对未定义完毕", ps->pos, 1);
+			return -1;
+		} else if(ps->in != ':') {
+			cave_jsonc_report_error(ps->doc, "键值之间应当使用冒号分隔", ps->pos, 1);
+			return -1;
+		}
+		if(ps->sax->key && ps->sax->key(ps->sax_user, key, length, kp))
+			return -1;
+		next(ps);
+		skip(ps);
+		if(cave_jsonc_has_fatal_error(ps->doc)) {
+			cave_jsonc_report_error(ps->doc, "键值之间应当使用冒号分隔", ps->pos, 1);
+			return -1;
+		}
+		return 1;
+	}
+	next(ps);
+	skip(ps);
+	return 0;
+}
+
+/**
+ * 移到数组的下一个元素，需要解析元素时返回1，数组结束时跳过右方括号并返回0
+ */
+static int sax_element(cave_jsonc_parser ps, struct sax_frame *frame) {
+	if(ps->in != ']') {
+		next(ps);
+		skip(ps);
+		if(ps->in != ']' || frame->count)// 空数组
+			return 1;
+	}
+	next(ps);
+	skip(ps);
+	return 0;
+}
+
+/**
+ * 容器中的一个值结束后检查分隔符并移到下一个成员，返回值同sax_member
+ */
+static int sax_next(cave_jsonc_parser ps, struct sax_frame *frame) {
+	frame->count++;
+	if(frame->object) {
+		if(ps->in < 0) {
+			cave_jsonc_report_error(ps->doc, "达到文件末尾对象花括号仍未配对", ps->pos, 1);
+			return -1;
+		} else if(ps->in != ',' && ps->in != '}') {
+			cave_jsonc_report_error(ps->doc, "相邻键值对之间应当使用逗号分隔", ps->pos, 1);
+			return -1;
+		}
+		return sax_member(ps, frame);
+	}
+	if(ps->in != ',' && ps->in != ']') {
+		cave_jsonc_report_error(ps->doc, "数组中相邻键之间应当使用逗号分隔", ps->pos, 1);
+		return -1;
+	}
+	return sax_element(ps, frame);
+}
+
+/**
+ * 发出容器的开始事件并入栈，读取它的第一个成员，返回值同sax_member
+ */
+static int sax_open(cave_jsonc_parser ps, size_t base) {
+	cave_jsonc_position p = ps->pos;
+	int object = ps->in == '{';
+	if(check_depth(ps, ps->sax_depth - base))
+		return -1;
+	if(object ? ps->sax->start_object && ps->sax->start_object(ps->sax_user, p) :
+			ps->sax->start_array && ps->sax->start_array(ps->sax_user, p))
+		return -1;
+	if(ps->sax_depth == ps->sax_cap) {
+		ps->sax_cap = ps->sax_cap ? ps->sax_cap * 2 : 16;
+		ps->sax_frames = realloc(ps->sax_frames, sizeof(struct sax_frame) * ps->sax_cap);
+	}
+	struct sax_frame *frame = &ps->sax_frames[ps->sax_depth++];
+	frame->object = object;
+	frame->count = 0;
+	return object ? sax_member(ps, frame) : sax_element(ps, frame);
+}
+
+/**
+ * 已经结束的容器出栈并发出结束事件，回调要求停止时返回非0
+ */
+static int sax_close(cave_jsonc_parser ps) {
+	struct sax_frame *frame = &ps->sax_frames[--ps->sax_depth];
+	if(frame->object)
+		return ps->sax->end_object && ps->sax->end_object(ps->sax_user);
+	return ps->sax->end_array && ps->sax->end_array(ps->sax_user);
+}
+
+/**
+ * 在显式的栈上迭代地按事件解析一个值，语法和错误信息与parse_value一致
+ * 出错或回调要求停止时返回非0
+ */
+static int sax_value(cave_jsonc_parser ps) {
+	size_t base = ps->sax_depth;
+	for(;;) {
+		// more为1时需要解析下一个值，为2时一个值已经结束，为-1时停止
+		int more;
+		if(ps->in == '{' || ps->in == '[') {
+			more = sax_open(ps, base);
+			if(!more)
+				more = sax_close(ps) ? -1 : 2;
+		} else
+			more = sax_scalar(ps) ? -1 : 2;
+		while(more == 2) {
+			if(ps->sax_depth == base)
+				return 0;
+			if(cave_jsonc_has_fatal_error(ps->doc))
+				more = -1;
+			else if(!(more = sax_next(ps, &ps->sax_frames[ps->sax_depth - 1])))
+				more = sax_close(ps) ? -1 : 2;
+		}
+		if(more < 0) {
+			ps->sax_depth = base;
+			return 1;
+		}
+	}
+}
+
+static cave_jsonc_document parse_events_root(cave_jsonc_parser ps, const cave_jsonc_sax_handler *handler, void *user) {
+	ps->pos = (cave_jsonc_position) {1, 1, 0};
+	ps->in = 0;
+	ps->doc = cave_jsonc_create_document();
+	ps->sax = handler;
+	ps->sax_user = user;
+	next(ps);
+	skip(ps);
+	if(!sax_value(ps) && !cave_jsonc_has_fatal_error(ps->doc) && ps->in > 0)
+		cave_jsonc_report_error(ps->doc, "解析完毕后文本仍有内容", ps->pos, 1);
+	cave_jsonc_document doc = ps->doc;
+	ps->doc = NULL;
+	ps->sax = NULL;
+	ps->sax_user = NULL;
+	ps->src = ps->src_end = NULL;
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parser_parse_events(cave_jsonc_parser ps, int (*fgetc)(void *file), void *file,
+		const cave_jsonc_sax_handler *handler, void *user) {
+	stream_input(ps, fgetc, file);
+	return parse_events_root(ps, handler, user);
+}
+
+cave_jsonc_document cave_jsonc_parser_parse_buffer_events(cave_jsonc_parser ps, const char *data, size_t length,
+		const cave_jsonc_sax_handler *handler, void *user) {
+	buffer_input(ps, data, length);
+	return parse_events_root(ps, handler, user);
+}
+
+cave_jsonc_document cave_jsonc_parse_events(int (*fgetc)(void *file), void *file,
+		const cave_jsonc_sax_handler *handler, void *user) {
+	struct _cave_jsonc_parser ps = {0};
+	cave_jsonc_document doc = cave_jsonc_parser_parse_events(&ps, fgetc, file, handler, user);
+	release_scratch(&ps);
+	return doc;
+}
+
+cave_jsonc_document cave_jsonc_parse_buffer_events(const char *data, size_t length,
+		const cave_jsonc_sax_handler *handler, void *user) {
+	struct _cave_jsonc_parser ps = {0};
+	cave_jsonc_document doc = cave_jsonc_parser_parse_buffer_events(&ps, data, length, handler, user);
+	release_scratch(&ps);
+	return doc;
+}
+
+struct push_builder {
+	cave_jsonc_document doc;
+	struct value_frame *frames;
+	size_t depth, cap;
+};
+
+static void builder_attach(struct push_builder *b, cave_jsonc_value value) {
+	if(!b->depth) {
+		cave_jsonc_set_document_root(b->doc, value);
+		return;
+	}
+	struct value_frame *frame = &b->frames[b->depth - 1];
+	if(frame->object) {
+		cave_jsonc_kvpair pair = doc_alloc(b->doc, sizeof(struct _cave_jsonc_kvpair));
+		pair->object = NULL;
+		pair->key = frame->key;
+		pair->value = value;
+		pair->position = frame->key_position;
+		cave_jsonc_move_kvpair_to_object(pair, frame->object->value.object);
+		cave_jsonc_insert_last_kvpair(frame->object->value.object, pair);
+		frame->key = NULL;
+	} else {
+		if(frame->length == frame->cap) {
+			frame->cap *= 2;
+			frame->values = realloc(frame->values, sizeof(cave_jsonc_value) * frame->cap);
+		}
+		frame->values[frame->length++] = value;
+	}
+}
+
+static struct value_frame *builder_push(struct push_builder *b, cave_jsonc_position position) {
+	if(b->depth == b->cap) {
+		b->cap = b->cap ? b->cap * 2 : 16;
+		b->frames = realloc(b->frames, sizeof(struct value_frame) * b->cap);
+	}
+	struct value_frame *frame = &b->frames[b->depth++];
+	frame->object = NULL;
+	frame->key = NULL;
+	frame->position = position;
+	frame->values = NULL;
+	frame->length = frame->cap = 0;
+	return frame;
+}
+
+/**
+ * 弹出最上层的容器并挂到上一层，未完成的键直接丢弃
+ */
+static void builder_pop(struct push_builder *b) {
+	struct value_frame frame = b->frames[--b->depth];
+	if(frame.object) {
+		if(frame.key)
+			release_string(b->doc, frame.key);
+		builder_attach(b, frame.object);
+	} else
+		builder_attach(b, make_array(b->doc, frame.values, frame.length, frame.position));
+}
+
+static int builder_start_object(void *user, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	cave_jsonc_value object = cave_jsonc_create_object_value(b->doc);
+	cave_jsonc_set_value_position(object, position);
+	builder_push(b, position)->object = object;
+	return 0;
+}
+
+static int builder_start_array(void *user, cave_jsonc_position position) {
+	struct value_frame *frame = builder_push(user, position);
+	frame->cap = 32;
+	frame->values = malloc(sizeof(cave_jsonc_value) * frame->cap);
+	return 0;
+}
+
+static int builder_end(void *user) {
+	builder_pop(user);
+	return 0;
+}
+
+static int builder_key(void *user, const char *key, size_t length, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	struct value_frame *frame = &b->frames[b->depth - 1];
+	frame->key = alloc_string(b->doc, key, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	frame->key_position = position;
+	return 0;
+}
+
+static int builder_string(void *user, const char *value, size_t length, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	cave_jsonc_value rval = alloc_value(b->doc, CAVE_JSONC_STRING);
+	cave_jsonc_set_value_position(rval, position);
+	rval->value.string = alloc_string(b->doc, value, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	builder_attach(b, rval);
+	return 0;
+}
+
+static int builder_number(void *user, const cave_jsonc_sax_number *number, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	cave_jsonc_value rval = alloc_value(b->doc, CAVE_JSONC_NUMBER);
+	cave_jsonc_set_value_position(rval, position);
+	struct _cave_jsonc_number *num = &rval->value.number;
+	if(number->integer) {
+		num->flag = CAVE_JSONC_NUM_IVAL;
+		num->ival = number->ival;
+	} else {
+		num->flag = CAVE_JSONC_NUM_FVAL;
+		num->fval = number->fval;
+	}
+	if(b->doc->flags & CAVE_JSONC_DOCUMENT_RAW_NUMBER) {
+		num->flag |= CAVE_JSONC_NUM_RAW;
+		num->raw = alloc_string(b->doc, number->raw, number->length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+	}
+	builder_attach(b, rval);
+	return 0;
+}
+
+static int builder_boolean(void *user, int value, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	cave_jsonc_value rval = cave_jsonc_create_boolean_value(b->doc, value);
+	cave_jsonc_set_value_position(rval, position);
+	builder_attach(b, rval);
+	return 0;
+}
+
+static int builder_null(void *user, cave_jsonc_position position) {
+	struct push_builder *b = user;
+	cave_jsonc_value rval = cave_jsonc_create_null_value(b->doc);
+	cave_jsonc_set_value_position(rval, position);
+	builder_attach(b, rval);
+	return 0;
+}
+
+static const cave_jsonc_sax_handler builder_handler = {
+	builder_start_object, builder_end, builder_start_array, builder_end,
+	builder_key, builder_string, builder_number, builder_boolean, builder_null,
+};
+
+/**
+ * 解析中途停止时把还没结束的容器挂到树上，与parse_value出错时保留的部分一致
+ */
+static void release_builder(struct push_builder *b) {
+	while(b->depth)
+		builder_pop(b);
+	free(b->frames);
+	free(b);
+}
+
+/**
+ * 推送式解析器的词法状态
+ */
+enum push_mode {
+	PUSH_SKIP,
+	PUSH_COMMENT_START,
+	PUSH_LINE_COMMENT,
+	PUSH_BLOCK_COMMENT,
+	PUSH_LITERAL,
+	PUSH_STRING,
+	PUSH_ESCAPE,
+	PUSH_HEX,
+	PUSH_SURROGATE_BACKSLASH,
+	PUSH_SURROGATE_U,
+	PUSH_NUMBER_INTEGER,
+	PUSH_NUMBER_FRACTION,
+	PUSH_NUMBER_EXPONENT_SIGN,
+	PUSH_NUMBER_EXPONENT,
+};
+
+/**
+ * 推送式解析器在跳过空白后期待的内容
+ */
+enum push_expect {
+	EXPECT_VALUE,
+	EXPECT_ARRAY_FIRST,
+	EXPECT_ARRAY_NEXT,
+	EXPECT_KEY_FIRST,
+	EXPECT_KEY,
+	EXPECT_COLON,
+	EXPECT_OBJECT_NEXT,
+	EXPECT_END,
+	EXPECT_DONE,
+};
+
+/**
+ * 推送式解析器的全部状态，输入可以在任意位置切开，包括记号、字符串和\u转义的中间
+ * 语法和错误信息与cave_jsonc_parse_document一致
+ */
+struct _cave_jsonc_push_parser {
+	cave_jsonc_document doc;
+	const cave_jsonc_sax_handler *handler;
+	void *user;
+	struct push_builder *builder;
+	int mode, expect, stopped;
+	/**
+	 * 当前字节的位置和上一个字节
+	 */
+	cave_jsonc_position pos;
+	int last;
+	/**
+	 * 当前记号的起始位置，注释开头的位置
+	 */
+	cave_jsonc_position start, comment;
+	/**
+	 * 嵌套的容器，'{'或'['
+	 */
+	char *stack;
+	size_t depth, stack_cap;
+	/**
+	 * 字符串或数字的内容，字符串是键时在冒号之前一直保留
+	 */
+	char *text;
+	size_t size, cap;
+	int key, space, prev, integer, hex, second;
+	unsigned ucs, high;
+	const char *literal;
+	int literal_value;
+};
+
+static void push_text(cave_jsonc_push_parser ps, const void *data, size_t n) {
+	if(ps->size + n >= ps->cap) {
+		while(ps->size + n >= ps->cap)
+			ps->cap *= 2;
+		ps->text = realloc(ps->text, ps->cap);
+	}
+	memcpy(ps->text + ps->size, data, n);
+	ps->size += n;
+}
+
+static inline void push_text_char(cave_jsonc_push_parser ps, char c) {
+	if(ps->size + 1 >= ps->cap) {
+		ps->cap *= 2;
+		ps->text = realloc(ps->text, ps->cap);
+	}
+	ps->text[ps->size++] = c;
+}
+
+static void push_utf8(cave_jsonc_push_parser ps, unsigned ucs) {
+	if(ucs < 0x80) {
+		push_text_char(ps, ucs);
+	} else if(ucs < 0x800) {
+		push_text_char(ps, (ucs >> 6) | 0xc0);
+		push_text_char(ps, (ucs & 0x3f) | 0x80);
+	} else if(ucs < 0x10000){
+		push_text_char(ps, (ucs >> 12) | 0xe0);
+		push_text_char(ps, ((ucs >> 6) & 0x3f) | 0x80);
+		push_text_char(ps, (ucs & 0x3f) | 0x80);
+	} else {
+		push_text_char(ps, (ucs >> 18) | 0xf0);
+		push_text_char(ps, ((ucs >> 12) & 0x3f) | 0x80);
+		push_text_char(ps, ((ucs >> 6) & 0x3f) | 0x80);
+		push_text_char(ps, (ucs & 0x3f) | 0x80);
+	}
+}
+
+static void push_error(cave_jsonc_push_parser ps, const char *message, cave_jsonc_position position) {
+	cave_jsonc_report_error(ps->doc, message, position, 1);
+	ps->stopped = 1;
+}
+
+/**
+ * 调用回调，回调要求停止时记录下来
+ */
+#define PUSH_EVENT(ps, name, ...) do { \
+		if((ps)->handler->name && (ps)->handler->name((ps)->user, __VA_ARGS__)) \
+			(ps)->stopped = 1; \
+	} while(0)
+
+/**
+ * 一个值结束后跳过空白，并根据所在的容器决定接下来期待什么
+ * 与parse_value一样，多余的斜杠报告错误后解析完当前的值就停止
+ */
+static void push_value_done(cave_jsonc_push_parser ps) {
+	if(ps->doc->fatal)
+		ps->stopped = 1;
+	if(!ps->depth)
+		ps->expect = EXPECT_END;
+	else
+		ps->expect = ps->stack[ps->depth - 1] == '[' ? EXPECT_ARRAY_NEXT : EXPECT_OBJECT_NEXT;
+	ps->mode = PUSH_SKIP;
+	ps->space = 0;
+}
+
+static void push_open(cave_jsonc_push_parser ps, char c) {
+	if(ps->depth == ps->stack_cap) {
+		ps->stack_cap = ps->stack_cap ? ps->stack_cap * 2 : 32;
+		ps->stack = realloc(ps->stack, ps->stack_cap);
+	}
+	ps->stack[ps->depth++] = c;
+	if(c == '{')
+		PUSH_EVENT(ps, start_object, ps->pos);
+	else
+		PUSH_EVENT(ps, start_array, ps->pos);
+	ps->expect = c == '{' ? EXPECT_KEY_FIRST : EXPECT_ARRAY_FIRST;
+	ps->mode = PUSH_SKIP;
+	ps->space = 0;
+}
+
+static void push_close(cave_jsonc_push_parser ps) {
+	if(ps->stack[--ps->depth] == '{') {
+		if(ps->handler->end_object && ps->handler->end_object(ps->user))
+			ps->stopped = 1;
+	} else if(ps->handler->end_array && ps->handler->end_array(ps->user))
+		ps->stopped = 1;
+	push_value_done(ps);
+}
+
+static void push_string_done(cave_jsonc_push_parser ps) {
+	if(ps->key) {
+		// 冒号之后才发出键的事件
+		ps->expect = EXPECT_COLON;
+		ps->mode = PUSH_SKIP;
+		ps->space = 0;
+		return;
+	}
+	PUSH_EVENT(ps, string, ps->text, ps->size, ps->start);
+	push_value_done(ps);
+}
+
+/**
+ * 数字在遇到不属于它的字符或输入结束时收尾，校验方式与lex_number一致
+ */
+static void push_number_done(cave_jsonc_push_parser ps) {
+	char last = ps->text[ps->size - 1];
+	if(last == '.') {
+		push_error(ps, "小数点后必须要有小数部分", ps->pos);
+		return;
+	} else if(last == '-') {
+		push_error(ps, "无意义的负号", ps->pos);
+		return;
+	} else if(last == 'e' || last == 'E') {
+		push_error(ps, "科学计数法必须要有指数位", ps->pos);
+		return;
+	} else if((ps->size >= 2 && ps->text[0] == '0' && ps->text[1] >= '0' && ps->text[1] <= '9') ||
+			(ps->size >= 3 && ps->text[0] == '-' && ps->text[1] == '0' && ps->text[2] >= '0' && ps->text[2] <= '9')) {
+		push_error(ps, "数字不得有前导0", ps->start);
+		return;
+	}
+	push_text_char(ps, '\0');
+	struct _cave_jsonc_number num;
+	num.flag = 0;
+	decode_number_text(&num, ps->text, ps->size - 1, ps->integer);
+	cave_jsonc_sax_number number;
+	number.raw = ps->text;
+	number.length = ps->size - 1;
+	number.integer = (num.flag & CAVE_JSONC_NUM_IVAL) != 0;
+	number.ival = number.integer ? num.ival : 0;
+	number.fval = number.integer ? (double) num.ival : num.fval;
+	PUSH_EVENT(ps, number, &number, ps->start);
+	push_value_done(ps);
+}
+
+/**
+ * 在跳过空白之后按语法处理一个字节，c为-1表示输入结束
+ * 返回0表示这个字节没有被消耗，需要在新的状态下再处理一次
+ */
+static int push_grammar(cave_jsonc_push_parser ps, int c) {
+	if(ps->doc->fatal && (ps->expect == EXPECT_ARRAY_NEXT || ps->expect == EXPECT_OBJECT_NEXT || ps->expect == EXPECT_END)) {
+		// 值之后的多余斜杠，与parse_value一样不再检查分隔符和末尾的内容
+		ps->stopped = 1;
+		return 1;
+	}
+	switch(ps->expect) {
+		case EXPECT_ARRAY_FIRST:
+			if(c == ']') {
+				push_close(ps);
+				return 1;
+			}
+			// fallthrough
+		case EXPECT_VALUE:
+			ps->start = ps->pos;
+			if(ps->doc->fatal && ps->depth && ps->stack[ps->depth - 1] == '{') {
+				// 与object_member一样，冒号之后已经有错误时不再解析值
+				push_error(ps, "键值之间应当使用冒号分隔", ps->pos);
+			} else if(c < 0) {
+				push_error(ps, "意料之外的文件结束", ps->pos);
+			} else if(c == 'n' || c == 't' || c == 'f') {
+				ps->literal = c == 'n' ? "ull" : c == 't' ? "rue" : "alse";
+				ps->literal_value = c;
+				ps->mode = PUSH_LITERAL;
+			} else if(c == '"') {
+				ps->key = 0;
+				ps->size = 0;
+				ps->mode = PUSH_STRING;
+			} else if((c >= '0' && c <= '9') || c == '-') {
+				ps->size = 0;
+				ps->integer = 1;
+				push_text_char(ps, c);
+				ps->mode = PUSH_NUMBER_INTEGER;
+			} else if(c == '{' || c == '[') {
+				push_open(ps, c);
+			} else
+				push_error(ps, "无法理解的内容", ps->pos);
+			return 1;
+		case EXPECT_ARRAY_NEXT:
+			if(c == ',') {
+				ps->expect = EXPECT_VALUE;
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+			} else if(c == ']')
+				push_close(ps);
+			else
+				push_error(ps, "数组中相邻键之间应当使用逗号分隔", ps->pos);
+			return 1;
+		case EXPECT_KEY:
+			if(c == '}') {
+				push_error(ps, "多余的逗号", ps->pos);
+				return 1;
+			}
+			// fallthrough
+		case EXPECT_KEY_FIRST:
+			if(c == '}') {
+				push_close(ps);
+			} else if(c == '"') {
+				ps->start = ps->pos;
+				ps->key = 1;
+				ps->size = 0;
+				ps->mode = PUSH_STRING;
+			} else
+				push_error(ps, "键只能是字符串", ps->pos);
+			return 1;
+		case EXPECT_COLON:
+			if(c < 0) {
+				push_error(ps, "达到文件末尾对象键值对未定义完毕", ps->pos);
+			} else if(c != ':') {
+				push_error(ps, "键值之间应当使用冒号分隔", ps->pos);
+			} else {
+				PUSH_EVENT(ps, key, ps->text, ps->size, ps->start);
+				ps->expect = EXPECT_VALUE;
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+			}
+			return 1;
+		case EXPECT_OBJECT_NEXT:
+			if(c < 0) {
+				push_error(ps, "达到文件末尾对象花括号仍未配对", ps->pos);
+			} else if(c == ',') {
+				ps->expect = EXPECT_KEY;
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+			} else if(c == '}')
+				push_close(ps);
+			else
+				push_error(ps, "相邻键值对之间应当使用逗号分隔", ps->pos);
+			return 1;
+		case EXPECT_END:
+			// 与parse_root一样，遇到\0就不再读取
+			if(c > 0)
+				push_error(ps, "解析完毕后文本仍有内容", ps->pos);
+			else
+				ps->expect = EXPECT_DONE;
+			return 1;
+		default:
+			return 1;
+	}
+}
+
+/**
+ * 处理一个字节，c为-1表示输入结束
+ */
+static int push_step(cave_jsonc_push_parser ps, int c) {
+	switch(ps->mode) {
+		case PUSH_SKIP:
+			// 与skip一样，注释只能跟在空白之后
+			if(ps->space && c == '/') {
+				ps->comment = ps->pos;
+				ps->mode = PUSH_COMMENT_START;
+				return 1;
+			} else if(is_space(c)) {
+				ps->space = 1;
+				return 1;
+			}
+			return push_grammar(ps, c);
+		case PUSH_COMMENT_START:
+			if(c == '/') {
+				ps->mode = PUSH_LINE_COMMENT;
+			} else if(c == '*') {
+				ps->prev = '/';
+				ps->mode = PUSH_BLOCK_COMMENT;
+			} else {
+				// 与skip一样，报告错误后从这个字节继续解析，不再跳过空白
+				cave_jsonc_report_error(ps->doc, "无意义内容", ps->comment, 1);
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+				return push_grammar(ps, c);
+			}
+			return 1;
+		case PUSH_LINE_COMMENT:
+			if(c == '\n') {
+				ps->mode = PUSH_SKIP;
+				ps->space = 1;
+			} else if(c < 0) {
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+				return 0;
+			}
+			return 1;
+		case PUSH_BLOCK_COMMENT:
+			if(c == '/' && ps->prev == '*') {
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+			} else if(c < 0) {
+				// 与skip一样，未闭合的注释在文件末尾多读一次
+				ps->pos.index++;
+				ps->pos.cols++;
+				ps->mode = PUSH_SKIP;
+				ps->space = 0;
+				return 0;
+			} else
+				ps->prev = c;
+			return 1;
+		case PUSH_LITERAL:
+			if(c != *ps->literal) {
+				push_error(ps, "无效内容", ps->pos);
+			} else if(!*++ps->literal) {
+				if(ps->literal_value == 'n')
+					PUSH_EVENT(ps, null, ps->start);
+				else
+					PUSH_EVENT(ps, boolean, ps->literal_value == 't', ps->start);
+				push_value_done(ps);
+			}
+			return 1;
+		case PUSH_STRING:
+			if(c == '"') {
+				push_string_done(ps);
+			} else if(c == '\\') {
+				ps->mode = PUSH_ESCAPE;
+			} else if(c < 0) {
+				push_error(ps, "引号在文件末尾仍未配对", ps->pos);
+			} else if(c == '\n') {
+				push_error(ps, "不能跨行书写字符串", ps->pos);
+			} else
+				push_text_char(ps, c);
+			return 1;
+		case PUSH_ESCAPE:
+			ps->mode = PUSH_STRING;
+			switch(c) {
+				case '\\': push_text_char(ps, '\\'); break;
+				case 'n': push_text_char(ps, '\n'); break;
+				case 'r': push_text_char(ps, '\r'); break;
+				case 't': push_text_char(ps, '\t'); break;
+				case 'b': push_text_char(ps, '\b'); break;
+				case 'f': push_text_char(ps, '\f'); break;
+				case '/': push_text_char(ps, '/'); break;
+				case '\'': push_text_char(ps, '\''); break;
+				case '"': push_text_char(ps, '"'); break;
+				case '0': push_text_char(ps, '\0'); break;
+				case 'u':
+					ps->mode = PUSH_HEX;
+					ps->hex = 0;
+					ps->ucs = 0;
+					ps->second = 0;
+					break;
+				default:
+					push_error(ps, "无效转义", ps->pos);
+			}
+			return 1;
+		case PUSH_HEX:
+			if(c < 0) {
+				push_error(ps, "UTF-16转义字符解析到达文件末尾", ps->pos);
+				return 1;
+			} else if(c >= '0' && c <='9') {
+				ps->ucs = (ps->ucs << 4) + (c - '0');
+			} else if (c >= 'a' && c <= 'f') {
+				ps->ucs = (ps->ucs << 4) + (c - 'a' + 10);
+			} else if (c >= 'A' && c <= 'F') {
+				ps->ucs = (ps->ucs << 4) + (c - 'A' + 10);
+			} else {
+				push_error(ps, "UTF-16转义字符必须以四位十六进制数表示", ps->pos);
+				return 1;
+			}
+			if(++ps->hex < 4)
+				return 1;
+			if(ps->second) {
+				push_utf8(ps, (((ps->high & (~ 0xfc00)) << 10) + 0x10000) | (ps->ucs & (~ 0xfc00)));
+				ps->mode = PUSH_STRING;
+			} else if((ps->ucs & 0xfc00) == 0xd800) {
+				ps->high = ps->ucs;
+				ps->mode = PUSH_SURROGATE_BACKSLASH;
+			} else if((ps->ucs & 0xfc00) == 0xdc00) {
+				push_error(ps, "代理对的转义必须成对存在，不能只有后半代理对", ps->pos);
+			} else {
+				push_utf8(ps, ps->ucs);
+				ps->mode = PUSH_STRING;
+			}
+			return 1;
+		case PUSH_SURROGATE_BACKSLASH:
+			if(c != '\\')
+				push_error(ps, "代理对的转义必须成对存在，不能只有前半代理对", ps->pos);
+			else
+				ps->mode = PUSH_SURROGATE_U;
+			return 1;
+		case PUSH_SURROGATE_U:
+			if(c != 'u') {
+				push_error(ps, "无效的代理对转义", ps->pos);
+			} else {
+				ps->mode = PUSH_HEX;
+				ps->hex = 0;
+				ps->ucs = 0;
+				ps->second = 1;
+			}
+			return 1;
+		case PUSH_NUMBER_INTEGER:
+			if(c >= '0' && c <= '9') {
+				push_text_char(ps, c);
+				return 1;
+			} else if(c == '.') {
+				if(ps->text[ps->size - 1] == '-') {
+					push_error(ps, "小数点前必须要有整数部分", ps->pos);
+					return 1;
+				}
+				ps->integer = 0;
+				push_text_char(ps, c);
+				ps->mode = PUSH_NUMBER_FRACTION;
+				return 1;
+			}
+			// fallthrough
+		case PUSH_NUMBER_FRACTION:
+			if(ps->mode == PUSH_NUMBER_FRACTION && c >= '0' && c <= '9') {
+				push_text_char(ps, c);
+				return 1;
+			} else if(c == 'e' || c == 'E') {
+				char last = ps->text[ps->size - 1];
+				if(last == '.') {
+					push_error(ps, "科学计数法小数点后必须要有小数部分", ps->pos);
+					return 1;
+				} else if(last == '-') {
+					push_error(ps, "科学计数法必须要有有效数位", ps->pos);
+					return 1;
+				}
+				ps->integer = 0;
+				push_text_char(ps, c);
+				ps->mode = PUSH_NUMBER_EXPONENT_SIGN;
+				return 1;
+			}
+			push_number_done(ps);
+			return 0;
+		case PUSH_NUMBER_EXPONENT_SIGN:
+			// 与lex_number一样，指数的第一个字符总是被消耗
+			ps->mode = PUSH_NUMBER_EXPONENT;
+			if(c == '-' || (c >= '0' && c <= '9')) {
+				push_text_char(ps, c);
+			} else if(c < 0) {
+				ps->pos.index++;
+				ps->pos.cols++;
+				push_number_done(ps);
+			}
+			return 1;
+		case PUSH_NUMBER_EXPONENT:
+			if(c >= '0' && c <= '9') {
+				push_text_char(ps, c);
+				return 1;
+			}
+			push_number_done(ps);
+			return 0;
+		default:
+			return 1;
+	}
+}
+
+static inline void push_position(cave_jsonc_push_parser ps, int c) {
+	if(ps->last == '\n') {
+		ps->pos.cols = 1;
+		ps->pos.row++;
+	}
+	ps->pos.index++;
+	ps->pos.cols++;
+	ps->last = c;
+}
+
+/**
+ * 一次跳过n个普通字节，位置的变化与逐个处理相同
+ */
+static void push_advance(cave_jsonc_push_parser ps, const unsigned char *p, size_t n) {
+	const unsigned char *last = NULL;
+	size_t lines = count_lines(p, p + n - 1, &last);
+	if(last) {
+		ps->pos.row += lines + (ps->last == '\n');
+		ps->pos.cols = 1 + (p + n - 1 - last);
+	} else if(ps->last == '\n') {
+		ps->pos.row++;
+		ps->pos.cols = 1 + n;
+	} else
+		ps->pos.cols += n;
+	ps->pos.index += n;
+	ps->last = p[n - 1];
+}
+
+static struct _cave_jsonc_push_parser *alloc_push_parser(cave_jsonc_document doc,
+		const cave_jsonc_sax_handler *handler, void *user) {
+	cave_jsonc_push_parser ps = calloc(1, sizeof(struct _cave_jsonc_push_parser));
+	ps->doc = doc;
+	ps->handler = handler;
+	ps->user = user;
+	ps->pos = (cave_jsonc_position) {1, 1, 0};
+	ps->mode = PUSH_SKIP;
+	ps->expect = EXPECT_VALUE;
+	ps->cap = 256;
+	ps->text = malloc(ps->cap);
+	return ps;
+}
+
+cave_jsonc_push_parser cave_jsonc_create_push_parser(int flags) {
+	cave_jsonc_document doc = cave_jsonc_create_document_with_flags(flags);
+	struct push_builder *builder = calloc(1, sizeof(struct push_builder));
+	builder->doc = doc;
+	cave_jsonc_push_parser ps = alloc_push_parser(doc, &builder_handler, builder);
+	ps->builder = builder;
+	return ps;
+}
+
+cave_jsonc_push_parser cave_jsonc_create_push_parser_with_handler(const cave_jsonc_sax_handler *handler, void *user) {
+	return alloc_push_parser(cave_jsonc_create_document(), handler, user);
+}
+
+int cave_jsonc_push_feed(cave_jsonc_push_parser ps, const char *chunk, size_t length) {
+	const unsigned char *p = (const unsigned char *) chunk, *end = p + length;
+	while(p < end && !ps->stopped && ps->expect != EXPECT_DONE) {
+		if(ps->mode == PUSH_STRING) {
+			// 整段复制不需要处理的字节
+			const unsigned char *special = SIMD_KERNEL(find_string_special)(p, end);
+			if(special > p) {
+				push_text(ps, p, special - p);
+				push_advance(ps, p, special - p);
+				p = special;
+				continue;
+			}
+		}
+		int c = *p++;
+		push_position(ps, c);
+		while(!push_step(ps, c) && !ps->stopped);
+	}
+	return ps->stopped;
+}
+
+cave_jsonc_document cave_jsonc_push_finish(cave_jsonc_push_parser ps) {
+	if(!ps->stopped && ps->expect != EXPECT_DONE) {
+		push_position(ps, -1);
+		while(!push_step(ps, -1) && !ps->stopped);
+	}
+	cave_jsonc_document doc = ps->doc;
+	if(ps->builder)
+		release_builder(ps->builder);
+	free(ps->stack);
+	free(ps->text);
+	free(ps);
+	return doc;
+}
+
+static size_t format_number(struct _cave_jsonc_number *num, char *out);
+
+/**
+ * 序列化器的全部状态，输出先写进obuf，满了再一次性交给fwrite
+ * fwrite为NULL时输出到内存，obuf满了就扩容
+ * 输出到fwrite时obuf在两次序列化之间保留
+ */
+struct _cave_jsonc_writer {
+	size_t (*ffwrite)(const void *data, size_t length, void *file);
+	void *fofile;
+	char *obuf;
+	size_t ocap, osize;
+	int ofailed;
+#ifdef CAVE_JSONC_STATS
+	cave_jsonc_stats *stats;
+	size_t depth;
+#endif
+};
+#define OUTPUT_CHUNK ((size_t) 64 << 10)
+
+static void out_flush(cave_jsonc_writer w) {
+	if(!w->ffwrite) {
+		w->ocap *= 2;
+		STAT_ALLOC(w->stats, w->ocap);
+		w->obuf = realloc(w->obuf, w->ocap);
+		return;
+	}
+	STAT_ADD(w->stats, bytes, w->osize);
+	if(w->osize && !w->ofailed && w->ffwrite(w->obuf, w->osize, w->fofile) != w->osize)
+		w->ofailed = 1;
+	w->osize = 0;
+}
+
+static inline void out_char(cave_jsonc_writer w, char c) {
+	w->obuf[w->osize++] = c;
+	if(w->osize == w->ocap)
+		out_flush(w);
+}
+
+static void out_write(cave_jsonc_writer w, const char *str, size_t length) {
+	while(w->ocap - w->osize <= length) {
+		size_t part = w->ocap - w->osize;
+		memcpy(w->obuf + w->osize, str, part);
+		w->osize += part;
+		str += part;
+		length -= part;
+		out_flush(w);
+	}
+	memcpy(w->obuf + w->osize, str, length);
+	w->osize += length;
+}
+
+static void sfoprint(cave_jsonc_writer w, const char *str) {
+	out_write(w, str, strlen(str));
+}
+
+/**
+ * 序列化字符串时需要特殊处理的字节：0到40的字节、反斜杠和可能是不可见字符的0xe2
+ * 找到下一个这样的字节，之前的部分可以整段输出
+ */
+typedef const unsigned char *(*escape_kernel)(const unsigned char *p, const unsigned char *end);
+
+static inline int need_escape(unsigned char c) {
+	return c <= 40 || c == '\\' || c == 0xe2;
+}
+
+static const unsigned char *find_escape_scalar(const unsigned char *p, const unsigned char *end) {
+	while(p < end && !need_escape(*p))
+		p++;
+	return p;
+}
+
+#ifdef CAVE_JSONC_X86_SIMD
+__attribute__((target("sse2")))
+static const unsigned char *find_escape_sse2(const unsigned char *p, const unsigned char *end) {
+	const __m128i low = _mm_set1_epi8(40), backslash = _mm_set1_epi8('\\'), lead = _mm_set1_epi8((char) 0xe2);
+	for(; end - p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) p);
+		__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, backslash), _mm_cmpeq_epi8(v, lead)),
+				_mm_cmpeq_epi8(_mm_max_epu8(v, low), low));
+		unsigned mask = _mm_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_escape_scalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const unsigned char *find_escape_avx2(const unsigned char *p, const unsigned char *end) {
+	const __m256i low = _mm256_set1_epi8(40), backslash = _mm256_set1_epi8('\\'), lead = _mm256_set1_epi8((char) 0xe2);
+	for(; end - p >= 32; p += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) p);
+		__m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, backslash), _mm256_cmpeq_epi8(v, lead)),
+				_mm256_cmpeq_epi8(_mm256_max_epu8(v, low), low));
+		unsigned mask = _mm256_movemask_epi8(special);
+		if(mask)
+			return p + __builtin_ctz(mask);
+	}
+	return find_escape_sse2(p, end);
+}
+#endif
+
+static const unsigned char *find_escape_dispatch(const unsigned char *p, const unsigned char *end);
+static escape_kernel find_escape = find_escape_dispatch;
+
+static const unsigned char *find_escape_dispatch(const unsigned char *p, const unsigned char *end) {
+	escape_kernel kernel = find_escape_scalar;
+#ifdef CAVE_JSONC_X86_SIMD
+	int level = simd_level();
+	if(level == SIMD_AVX2)
+		kernel = find_escape_avx2;
+	else if(level == SIMD_SSE2)
+		kernel = find_escape_sse2;
+#endif
+	__atomic_store_n(&find_escape, kernel, __ATOMIC_RELAXED);
+	return kernel(p, end);
+}
+
+/**
+ * U+200B到U+200D的零宽字符和U+202A到U+202E的方向控制字符不可见，转义后输出
+ * 它们的UTF-8编码都是e2 80 xx
+ */
+static int is_invisible(const unsigned char *p, const unsigned char *end) {
+	return end - p >= 3 && p[1] == 0x80 &&
+		((p[2] >= 0x8b && p[2] <= 0x8d) || (p[2] >= 0xaa && p[2] <= 0xae));
+}
+
+static void serialize_string(cave_jsonc_writer w, cave_jsonc_string string) {
+	static const char hex[] = "0123456789abcdef";
+	const unsigned char *p = (const unsigned char *) string->value, *end = p + string->length;
+	STAT_BEGIN(w->stats);
+	out_char(w, '"');
+	while(p < end) {
+		const unsigned char *run = SIMD_KERNEL(find_escape)(p, end);
+		out_write(w, (const char *) p, run - p);
+		STAT_ADD(w->stats, string_bytes_copied, run - p);
+		if(run == end)
+			break;
+		p = run;
+		if(*p == 0xe2) {
+			if(is_invisible(p, end)) {
+				char head[7] = "\\u20";
+				head[4] = hex[(p[2] >> 4) & 3];
+				head[5] = hex[p[2] & 15];
+				out_write(w, head, 6);
+				STAT_ADD(w->stats, string_bytes_escaped, 3);
+				p += 3;
+			} else {
+				out_char(w, *p++);
+				STAT_ADD(w->stats, string_bytes_copied, 1);
+			}
+			continue;
+		}
+		switch (*p) {
+			case '\\':
+				out_write(w, "\\\\", 2);
+				break;
+			case '\n':
+				out_write(w, "\\n", 2);
+				break;
+			case '\r':
+				out_write(w, "\\r", 2);
+				break;
+			case '\t':
+				out_write(w, "\\t", 2);
+				break;
+			case '\b':
+				out_write(w, "\\b", 2);
+				break;
+			case '\f':
+				out_write(w, "\\f", 2);
+				break;
+			case '"':
+				out_write(w, "\\\"", 2);
+				break;
+			case '\0':
+				out_write(w, "\\0", 2);
+				break;
+			default: {
+				char head[6] = "\\u00";
+				head[4] = hex[*p >> 4];
+				head[5] = hex[*p & 15];
+				out_write(w, head, 6);
+			}
+		}
+		STAT_ADD(w->stats, string_bytes_escaped, 1);
+		p++;
+	}
+	out_char(w, '"');
+	STAT_END(w->stats, string_ns);
+}
+
+static void print_tab(cave_jsonc_writer w, int count) {
+	for(int i = 0; i < count; i++)
+		out_char(w, '\t');
+}
+
+/**
+ * 序列化时容器的嵌套层数只在统计时记录
+ */
+#ifdef CAVE_JSONC_STATS
+#define STAT_ENTER(w) do { if((w)->stats) { (w)->depth++; STAT_MAX((w)->stats, max_depth, (w)->depth); } } while(0)
+#define STAT_LEAVE(w) do { if((w)->stats) (w)->depth--; } while(0)
+#else
+#define STAT_ENTER(w) ((void) 0)
+#define STAT_LEAVE(w) ((void) 0)
+#endif
+
+static void serialize_value(cave_jsonc_writer w, cave_jsonc_value value, int mininize, int tab) {
+	STAT_ADD(w->stats, nodes[cave_jsonc_get_value_type(value)], 1);
+	switch (cave_jsonc_get_value_type(value)) {
+		case CAVE_JSONC_UNDEFINED:
+		case CAVE_JSONC_NULL:
+			sfoprint(w, "null");
+			break;
+		case CAVE_JSONC_BOOLEAN:
+			sfoprint(w, value->value.boolean ? "true" : "false");
+			break;
+		case CAVE_JSONC_NUMBER: {
+			STAT_BEGIN(w->stats);
+			if(value->value.number.flag & CAVE_JSONC_NUM_RAW) {
+				out_write(w, value->value.number.raw->value, value->value.number.raw->length);
+			} else {
+				char head[64];
+				out_write(w, head, format_number(&value->value.number, head));
+			}
+			STAT_END(w->stats, number_ns);
+			break;
+		}
+		case CAVE_JSONC_STRING:
+			serialize_string(w, value->value.string);
+			break;
+		case CAVE_JSONC_OBJECT:
+			STAT_ENTER(w);
+			out_char(w, '{');
+			cave_jsonc_object object = cave_jsonc_get_object(value);
+			cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(object);
+			int first = 1;
+			while(pair) {
+				if(pair->value != NULL) {
+					if(!first)
+						out_char(w, ',');
+					if(!mininize) {
+						out_char(w, '\n');
+						print_tab(w, tab + 1);
+					}
+					first = 0;
+					serialize_string(w, pair->key);
+					if(!mininize)
+						out_char(w, ' ');
+					out_char(w, ':');
+					if(!mininize)
+						out_char(w, ' ');
+					serialize_value(w, pair->value, mininize, tab + 1);
+				}
+				pair = cave_jsonc_next_kvpair(pair);
+			}
+			if(!mininize && !first) {
+				out_char(w, '\n');
+				print_tab(w, tab);
+			}
+			out_char(w, '}');
+			STAT_LEAVE(w);
+			break;
+		case CAVE_JSONC_ARRAY:
+			STAT_ENTER(w);
+			out_char(w, '[');
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			first = 1;
+			for(int i = 0; i < array->length; i++) {
+				if(!first)
+					out_char(w, ',');
+				if(!mininize)
+					out_char(w, ' ');
+				first = 0;
+				serialize_value(w, array->values[i], mininize, tab);
+			}
+			out_char(w, ']');
+			STAT_LEAVE(w);
+			break;
+	}
+}
+
+cave_jsonc_writer cave_jsonc_create_writer(void) {
+	return calloc(1, sizeof(struct _cave_jsonc_writer));
+}
+
+void cave_jsonc_release_writer(cave_jsonc_writer w) {
+	free(w->obuf);
+	free(w);
+}
+
+void cave_jsonc_writer_set_stats(cave_jsonc_writer w, cave_jsonc_stats *stats) {
+#ifdef CAVE_JSONC_STATS
+	w->stats = stats;
+#else
+	(void) w;
+	(void) stats;
+#endif
+}
+
+static void serialize_root(cave_jsonc_writer w, cave_jsonc_document doc, int mininize) {
+	if(!w->obuf) {
+		w->ocap = OUTPUT_CHUNK;
+		STAT_ALLOC(w->stats, w->ocap);
+		w->obuf = malloc(w->ocap);
+	}
+	w->osize = 0;
+	w->ofailed = 0;
+#ifdef CAVE_JSONC_STATS
+	uint64_t stat_start = w->stats ? stat_clock() : 0, stat_before = w->stats ? stat_phases(w->stats) : 0;
+#endif
+	if(doc->root)
+		serialize_value(w, cave_jsonc_get_document_root(doc), mininize, 0);
+#ifdef CAVE_JSONC_STATS
+	if(w->stats)
+		w->stats->structure_ns += stat_clock() - stat_start - (stat_phases(w->stats) - stat_before);
+#endif
+}
+
+int cave_jsonc_writer_serialize_to_sink(cave_jsonc_writer w, cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int mininize) {
+	if(!doc->root)
+		return 0;
+	w->ffwrite = fwrite;
+	w->fofile = file;
+	serialize_root(w, doc, mininize);
+	out_flush(w);
+	w->fofile = NULL;
+	return w->ofailed ? -1 : 0;
+}
+
+char *cave_jsonc_writer_serialize_to_memory(cave_jsonc_writer w, cave_jsonc_document doc, int mininize, size_t *length) {
+	w->ffwrite = NULL;
+	w->fofile = NULL;
+	serialize_root(w, doc, mininize);
+	w->obuf[w->osize] = '\0';
+	STAT_ADD(w->stats, bytes, w->osize);
+	if(length)
+		*length = w->osize;
+	// 输出交给调用者，下次序列化重新分配
+	char *rval = realloc(w->obuf, w->osize + 1);
+	w->obuf = NULL;
+	return rval;
+}
+
+int cave_jsonc_serialize_document_to_sink(cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int mininize) {
+	struct _cave_jsonc_writer w = {0};
+	int rval = cave_jsonc_writer_serialize_to_sink(&w, doc, fwrite, file, mininize);
+	free(w.obuf);
+	return rval;
+}
+
+char *cave_jsonc_serialize_document_to_memory(cave_jsonc_document doc, int mininize, size_t *length) {
+	struct _cave_jsonc_writer w = {0};
+	return cave_jsonc_writer_serialize_to_memory(&w, doc, mininize, length);
+}
+
+/**
+ * 把逐字符的fputc接口包装成整块写出的接口
+ */
+struct fputc_sink {
+	int (*fputc)(int c, void *file);
+	void *file;
+};
+
+static size_t fputc_write(const void *data, size_t length, void *file) {
+	struct fputc_sink *sink = file;
+	for(size_t i = 0; i < length; i++)
+		if(sink->fputc(((const unsigned char *) data)[i], sink->file) < 0)
+			return i;
+	return length;
+}
+
+int cave_jsonc_serialize_document(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file, int mininize) {
+	struct fputc_sink sink = {fputc, file};
+	return cave_jsonc_serialize_document_to_sink(doc, fputc_write, &sink, mininize);
+}
+
+static void ffputs(int (*fputc)(int c, void *file), void *file, const char *str) {
+	for(size_t i = 0; str[i]; i++)
+		fputc(str[i], file);
+}
+
+int cave_jsonc_print_error(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file) {
+	cave_jsonc_error err = doc->error_head;
+	char head[100];
+	size_t count = 0;
+	while(err) {
+		if(err->position.row > 0 && err->position.cols > 0) {
+			if(err->fatal > 0)
+				sprintf(head, "%ld:%ld: 错误: ", err->position.row, err->position.cols);
+			else if (err->fatal == 0)
+				sprintf(head, "%ld:%ld: 警告: ", err->position.row, err->position.cols);
+			else
+				sprintf(head, "%ld:%ld: 信息: ", err->position.row, err->position.cols);
+		} else {
+			if(err->fatal > 0)
+				strcpy(head, "<未知>: 错误: ");
+			else if (err->fatal == 0)
+				strcpy(head, "<未知>: 警告: ");
+			else
+				strcpy(head, "<未知>: 信息: ");
+		}
+		ffputs(fputc, file, head);
+		ffputs(fputc, file, err->message);
+		fputc('\n', file);
+		count += err->fatal >= 0;
+		err = err->next;
+	}
+	if(count) {
+		sprintf(head, "共 %ld 个错误或警告\n", count);
+		ffputs(fputc, file, head);
+	}
+	return count;
+}
+
+int cave_jsonc_has_fatal_error(cave_jsonc_document doc) {
+	return doc->fatal;
+}
+
+int cave_jsonc_report_error(cave_jsonc_document doc, const char *message, cave_jsonc_position position, int fatal) {
+	int rval = doc->fatal;
+	STAT_ADD(doc->stats, errors, fatal > 0);
+	STAT_ADD(doc->stats, warnings, fatal == 0);
+	STAT_ALLOC(doc->stats, sizeof(struct _cave_jsonc_error));
+	cave_jsonc_error err = malloc(sizeof(struct _cave_jsonc_error));
+	err->fatal = fatal;
+	err->message = message;
+	err->position = position;
+	err->next = NULL;
+	if(doc->error_tail)
+		doc->error_tail = doc->error_tail->next = err;
+	else
+		doc->error_head = doc->error_tail = err;
+	if(fatal)
+		doc->fatal = 1;
+	return rval;
+}
+
+/**
+ * 只有原始文本的数字在第一次读取时解码
+ */
+static void decode_raw_number(struct _cave_jsonc_number *num) {
+	const char *s = num->raw->value;
+	int integer = !strpbrk(s, ".eE");
+	decode_number_text(num, s, strlen(s), integer);
+}
+
+/**
+ * 浮点数转换为整数，超出范围时取最接近的值，NaN为0
+ */
+static long long double_to_integer(double fval) {
+	if(fval >= (double) LLONG_MAX)
+		return LLONG_MAX;
+	if(fval <= (double) LLONG_MIN)
+		return LLONG_MIN;
+	return fval == fval ? (long long) fval : 0;
+}
+
+long long cave_jsonc_get_integer(cave_jsonc_value value) {
+	struct _cave_jsonc_number *num = &value->value.number;
+	if(!(num->flag & (CAVE_JSONC_NUM_IVAL | CAVE_JSONC_NUM_FVAL)))
+		decode_raw_number(num);
+	if(num->flag & CAVE_JSONC_NUM_IVAL)
+		return num->ival;
+	return double_to_integer(num->fval);
+}
+
+double cave_jsonc_get_double(cave_jsonc_value value) {
+	struct _cave_jsonc_number *num = &value->value.number;
+	if(!(num->flag & (CAVE_JSONC_NUM_IVAL | CAVE_JSONC_NUM_FVAL)))
+		decode_raw_number(num);
+	return num->flag & CAVE_JSONC_NUM_IVAL ? (double) num->ival : num->fval;
+}
+
+/**
+ * Schubfach算法用的10^-k近似值floor(10^-k*2^-r)+1，拆成高63位和低63位，k从-324到292
+ */
+#define SCHUBFACH_K_MIN (-324)
+
+static const uint64_t schubfach_table[][2] = {
+	{0x4f0cedc95a718dd4, 0x5b01e8b09aa0d1b5},
+	{0x7e7b160ef71c1621, 0x119ca780f767b5ee},
+	{0x652f44d8c5b011b4, 0x0e16ec672c52f7f2},
+	{0x50f29d7a37c00e29, 0x581256b8f0425ff5},
+	{0x40c21794f96671ba, 0x79a84560c0351991},
+	{0x679cf287f570b5f7, 0x75da089acd21c281},
+	{0x52e3f5399126f7f9, 0x44ae6d48a41b0201},
+	{0x424ff76140ebf994, 0x36f1f106e9af34cd},
+	{0x6a198bcece465c20, 0x57e981a4a918547b},
+	{0x54e13ca571d1e34d, 0x2cbace1d541376c9},
+	{0x43e763b78e4182a4, 0x23c8a4e44342c56e},
+	{0x6ca56c58e39c043a, 0x060dd4a06b9e08b0},
+	{0x56eabd13e9499cfb, 0x1e7176e6bc7e6d59},
+	{0x458897432107b0c8, 0x7ec12bebc9febde1},
+	{0x6f40f20501a5e7a7, 0x7e01dfdfa9979635},
+	{0x5900c19d9aeb1fb9, 0x4b34b319547944f7},
+	{0x4733ce17af227fc7, 0x55c3c27aa9fa9d93},
+	{0x71ec7cf2b1d0cc72, 0x560603f7765dc8ea},
+	{0x5b2397288e40a38e, 0x7804cff92b7e3a55},
+	{0x48e945ba0b66e93f, 0x13370cc755fe9511},
+	{0x74a86f90123e41fe, 0x51f1ae0bbcca881b},
+	{0x5d538c7341cb67fe, 0x74c1580963d539af},
+	{0x4aa93d29016f8665, 0x43cde0078310faf3},
+	{0x77752ea8024c0a3c, 0x0616333f381b2b1e},
+	{0x5f90f22001d66e96, 0x3811c298f9af55b1},
+	{0x4c73f4e667debede, 0x600e35472e25de28},
+	{0x7a532170a6313164, 0x3349eed849d6303f},
+	{0x61dc1ac084f42783, 0x42a18be03b11c033},
+	{0x4e49af006a5cec69, 0x1bb46fe695a7ccf5},
+	{0x7d42b19a43c7e0a8, 0x2c53e63dbc3fae55},
+	{0x64355ae1cfd31a20, 0x237651cafcffbeaa},
+	{0x502aaf1b0ca8e1b3, 0x35f8416f30cc9888},
+	{0x402225af3d53e7c2, 0x5e603458f3d6e06d},
+	{0x669d0918621fd937, 0x4a3386f4b957cd7b},
+	{0x52173a79e8197a92, 0x6e8f9f2a2ddfd796},
+	{0x41ac2ec7ece12edb, 0x720c7f54f17fdfab},
+	{0x69137e0cae3517c6, 0x1ce0cbbb1bffcc45},
+	{0x540f980a24f74638, 0x171a3c95afffd69e},
+	{0x433facd4ea5f6b60, 0x127b63aaf3331218},
+	{0x6b991487dd657899, 0x6a5f05de51eb5026},
+	{0x5614106cb11dfa14, 0x5518d17ea7ef7352},
+	{0x44dcd9f08db194dd, 0x2a7a41321ff2c2a8},
+	{0x6e2e2980e2b5bafb, 0x5d906850331e043f},
+	{0x5824ee00b55e2f2f, 0x647386a68f4b3699},
+	{0x4683f19a2ab1bf59, 0x36c2d21ed908f87b},
+	{0x70d31c29dde93228, 0x579e1cfe280e5a5d},
+	{0x5a427cee4b20f4ed, 0x2c7e7d98200b7b7e},
+	{0x483530bea280c3f1, 0x09fecae019a2c932},
+	{0x73884dfdd0ce064e, 0x43314499c29e0eb6},
+	{0x5c6d0b3173d8050b, 0x4f5a9d47cee4d891},
+	{0x49f0d5c129799da2, 0x72aee4397250ad41},
+	{0x764e22cea8c295d1, 0x377e39f583b44868},
+	{0x5ea4e8a553cede41, 0x12cb61913629d387},
+	{0x4bb72084430be500, 0x756f8140f8217605},
+	{0x792500d39e796e67, 0x6f18cece59cf233c},
+	{0x60ea670fb1fabeb9, 0x3f470bd847d8e8fd},
+	{0x4d885272f4c89894, 0x329f3cad064720ca},
+	{0x7c0d50b7ee0dc0ed, 0x37652de1a3a50143},
+	{0x633dda2cbe716724, 0x2c50f1814fb73436},
+	{0x4f64ae8a31f45283, 0x3d0d8e010c92902b},
+	{0x7f077da9e986ea6b, 0x7b48e334e0ea8045},
+	{0x659f97bb2138bb89, 0x49071c2a4d88669d},
+	{0x514c796280fa2fa1, 0x20d27ceea46d1ee4},
+	{0x4109fab533fb594d, 0x670eca58838a7f1d},
+	{0x680ff788532bc216, 0x0b4add5a6c10cb62},
+	{0x533ff939dc2301ab, 0x22a24aaebcda3c4e},
+	{0x4299942e49b59aef, 0x354ea22563e1c9d8},
+	{0x6a8f537d42bc2b18, 0x554a9d089fcfa95a},
+	{0x553f75fdcefcef46, 0x776ee406e63fbaae},
+	{0x4432c4cb0bfd8c38, 0x5f8be99f1e996225},
+	{0x6d1e07ab466279f4, 0x327975cb64289d08},
+	{0x574b3955d1e86190, 0x28612b091ced4a6d},
+	{0x45d5c777db204e0d, 0x06b4226db0bdd524},
+	{0x6fbc72595e9a167b, 0x24536a491ac95506},
+	{0x59638eade54811fc, 0x1d0f883a7bd44405},
+	{0x4782d88b1dd34196, 0x4a72d361fca9d004},
+	{0x726af411c952028a, 0x43eaebcffaa94cd3},
+	{0x5b88c3416ddb353b, 0x4fef230cc88770a9},
+	{0x493a35cdf17c2a96, 0x0cbf4f3d6d3926ee},
+	{0x7529efafe8c6aa89, 0x61321862485b717c},
+	{0x5dbb262653d22207, 0x675b46b506af8dfd},
+	{0x4afc1e850fdb4e6c, 0x52af6bc405593e64},
+	{0x77f9ca6e7fc54a47, 0x377f12d33bc1fd6d},
+	{0x5ffb085866376e9f, 0x45ff42429634cabd},
+	{0x4cc8d379eb5f8bb2, 0x6b329b68782a3bcb},
+	{0x7adaebf64565ac51, 0x2b842bda59dd2c77},
+	{0x6248bcc5045156a7, 0x3c69bcaeae4a89f9},
+	{0x4ea0970403744552, 0x6387ca25583ba194},
+	{0x7dcdbe6cd253a21e, 0x05a6103bc05f68ed},
+	{0x64a498570ea94e7e, 0x37b80cfc99e5ed8a},
+	{0x5083ad1272210b98, 0x2c933d96e184be08},
+	{0x40695741f4e73c79, 0x7075cadf1ad09807},
+	{0x670ef2032171fa5c, 0x4d8944982ae759a4},
+	{0x52725b35b45b2eb0, 0x3e076a135585e150},
+	{0x41f515c49048f226, 0x64d2bb42aad1810d},
+	{0x698822d41a0e503e, 0x07b7920444826815},
+	{0x546ce8a9ae71d9cb, 0x1fc60e69d0685344},
+	{0x438a53baf1f4ae3c, 0x196b3ebb0d20429d},
+	{0x6c1085f7e9877d2d, 0x0f11fdf815006a94},
+	{0x56739e5fee05fdbd, 0x58db319344005543},
+	{0x45294b7ff19e6497, 0x60af5adc3666aa9c},
+	{0x6ea878ccb5ca3a8c, 0x344bc4938a3dddc7},
+	{0x5886c70a2b082ed6, 0x5d096a0fa1cb17d2},
+	{0x46d238d4ef39bf12, 0x173abb3fb4a27975},
+	{0x71505aee4b8f981d, 0x0b912b992103f588},
+	{0x5aa6af25093face4, 0x0940efadb4032ad3},
+	{0x488558ea6dcc8a50, 0x07672624900288a9},
+	{0x74088e43e2e0dd4c, 0x723ea36db337410e},
+	{0x5cd3a5031be71770, 0x5b654f8af5c5cda5},
+	{0x4a42ea68e31f45f3, 0x62b772d5916b0aeb},
+	{0x76d1770e38320986, 0x0458b7bc1bde77dd},
+	{0x5f0df8d82cf4d46b, 0x1d13c630164b9318},
+	{0x4c0b2d79bd90a9ef, 0x30dc9e8cdea2dc13},
+	{0x79ab7bf5fc1aa97f, 0x0160fdae31049351},
+	{0x6155fcc4c9aeedff, 0x1ab3fe24f403a90e},
+	{0x4dde63d0a158be65, 0x6229981d9002eda5},
+	{0x7c97061a9bc130a2, 0x69dc2695b337e2a1},
+	{0x63ac04e2163426e8, 0x54b01ede28f9821b},
+	{0x4fbcd0b4de901f20, 0x43c018b1ba6134e2},
+	{0x7f9481216419cb67, 0x1f99c11c5d68549d},
+	{0x6610674de9ae3c52, 0x4c7b00e37ded107e},
+	{0x51a6b90b21583042, 0x09fc00b5fe574065},
+	{0x41522da2811359ce, 0x3b3000919845cd1d},
+	{0x68837c3734ebc2e3, 0x784ccdb5c06fae95},
+	{0x539c635f5d8968b6, 0x2d0a3e2b00595877},
+	{0x42e382b2b13aba2b, 0x3da1cb5599e11393},
+	{0x6b059deab52ac378, 0x629c7888f634ec1e},
+	{0x559e17eef755692d, 0x3549fa072b5d89b1},
+	{0x447e798bf91120f1, 0x1107fb38ef7e07c1},
+	{0x6d9728dff4e834b5, 0x01a65ec17f300c68},
+	{0x57ac20b32a535d5d, 0x4e1eb23465c009ed},
+	{0x46234d5c21dc4ab1, 0x24e55b5d1e333b24},
+	{0x70387bc69c93aab5, 0x216ef894fd1ec506},
+	{0x59c6c96bb076222a, 0x4df2607730e56a6c},
+	{0x47d23abc8d2b4e88, 0x3e5b805f5a5121f0},
+	{0x72e9f79415121740, 0x63c59a322a1b697f},
+	{0x5bee5fa9aa74df67, 0x03047b5b54e2bacc},
+	{0x498b7fbaeec3e5ec, 0x0269fc4910b5623d},
+	{0x75abff917e063cac, 0x6a432d41b45569fb},
+	{0x5e2332dacb38308a, 0x21cf5767c37787fc},
+	{0x4b4f5be23c2cf3a1, 0x67d912b9692c6cca},
+	{0x787ef969f9e185cf, 0x595b5128a8471476},
+	{0x60659454c7e79e3f, 0x6115da86ed05a9f8},
+	{0x4d1e1043d31fb1cc, 0x4dab1538bd9e2193},
+	{0x7b634d3951cc4fad, 0x62ab552795c9cf52},
+	{0x62b5d7610e3d0c8b, 0x0222aa86116e3f75},
+	{0x4ef7df80d830d6d5, 0x4e822204dabe992a},
+	{0x7e59659af38157bc, 0x17369cd49130f510},
+	{0x65145148c2cddfc9, 0x5f5ee3dd40f3f740},
+	{0x50dd0dd3cf0b196e, 0x1918b64a9a5cc5cd},
+	{0x40b0d7dca5a27abe, 0x4746f83baeb09e3e},
+	{0x678159610903f797, 0x253e59f91780fd2f},
+	{0x52cde11a6d9cc612, 0x50feae60df9a6426},
+	{0x423e4daebe1704db, 0x5a65584d7faeb685},
+	{0x69fd4917968b3af9, 0x10a226e265e4573b},
+	{0x54caa0dfaba29594, 0x0d4e8581eb1d1295},
+	{0x43d54d7fbc821143, 0x243ed134bc174211},
+	{0x6c887bff94034ed2, 0x06cae85460253682},
+	{0x56d396661002a574, 0x6bd586a9e6842b9b},
+	{0x457611eb40021df7, 0x09779eee52035616},
+	{0x6f234fdeccd02ff1, 0x5bf297e3b66bbcef},
+	{0x58e90cb23d73598e, 0x165bacb62b8963f3},
+	{0x4720d6f4fdf5e13e, 0x451623c4efa11cc2},
+	{0x71ce24bb2fefceca, 0x3b569fa17f682e03},
+	{0x5b0b5095bff30bd5, 0x15dee61acc535803},
+	{0x48d5da11665c0977, 0x2b18b8157042accf},
+	{0x74895ce8a3c6758b, 0x5e8df355806aae18},
+	{0x5d3ab0ba1c9ec46f, 0x653e5c4466bbbe7a},
+	{0x4a955a2e7d4bd059, 0x3765169d1efc9861},
+	{0x77555d172edfb3c2, 0x256e8a94fe60f3cf},
+	{0x5f777dac257fc301, 0x6abed543feb3f63f},
+	{0x4c5f97bceacc9c01, 0x3bcbddcffef65e99},
+	{0x7a328c6177adc668, 0x5fac961997f0975b},
+	{0x61c209e792f16b86, 0x7fbd44e1465a12af},
+	{0x4e34d4b9425abc6b, 0x7fca9d810514dbbf},
+	{0x7d21545b9d5dfa46, 0x32ddc8ce6e87c5ff},
+	{0x641aa9e2e44b2e9e, 0x5be4a0a525396b32},
+	{0x501554b5836f587e, 0x7cb6e6ea842def5c},
+	{0x4011109135f2ad32, 0x30925255368b25e3},
+	{0x6681b41b89844850, 0x4db6ea21f0dea304},
+	{0x52015ce2d469d373, 0x57c5881b2718826a},
+	{0x419ab0b576bb0f8f, 0x5fd139af527a01ef},
+	{0x68f781225791b27f, 0x4c81f5e550c3364a},
+	{0x53f9341b79415b99, 0x239b2b1dda35c508},
+	{0x432dc3492dcde2e1, 0x02e288e4ae916a6d},
+	{0x6b7c6ba849496b01, 0x516a74a1174f10ae},
+	{0x55fd22ed076def34, 0x4121f6e745d8da25},
+	{0x44ca82573924bf5d, 0x1a8192529e4714eb},
+	{0x6e10d08b8ea1322e, 0x5d9c1d50fd3e87dd},
+	{0x580d73a2d880f4f2, 0x17b01773fdcb9fe4},
+	{0x4671294f139a5d8e, 0x4626792997d61984},
+	{0x70b50ee4ec2a2f4a, 0x3d0a5b75bfbcf59f},
+	{0x5a2a7250bcee8c3b, 0x4a6eaf916630c47f},
+	{0x4821f50d63f209c9, 0x21f2260deb5a36cc},
+	{0x736988156cb6760e, 0x69837016455d247a},
+	{0x5c546cddf091f80b, 0x6e02c011d1175062},
+	{0x49dd23e4c074c66f, 0x719bccdb0dac404e},
+	{0x762e9fd467213d7f, 0x68f947c4e2ad33b0},
+	{0x5e8bb3105280fdff, 0x6d94396a4ef0f627},
+	{0x4ba2f5a6a8673199, 0x3e102deea58d91b9},
+	{0x7904bc3dda3eb5c2, 0x3019e3176f48e927},
+	{0x60d09697e1cbc49b, 0x4014b5ac590720ec},
+	{0x4d73abacb4a303af, 0x4cdd5e237a6c1a57},
+	{0x7bec45e12104d2b2, 0x47c8969f2a46908a},
+	{0x63236b1a80d0a88e, 0x6ca0787f5505406f},
+	{0x4f4f88e200a6ed3f, 0x0a19f9ff773766bf},
+	{0x7ee5a7d0010b1531, 0x5cf65ccbf1f23dfe},
+	{0x6584864000d5aa8e, 0x172b7d6ff4c1cb32},
+	{0x5136d1cccd77bba4, 0x78ef978cc3ce3c28},
+	{0x40f8a7d70ac62fb7, 0x13f2dfa3cfd83020},
+	{0x67f43fbe77a37f8b, 0x398499061959e699},
+	{0x5329cc985fb5ffa2, 0x6136e0d1ade18548},
+	{0x4287d6e04c91994f, 0x00f8b3daf181376d},
+	{0x6a72f166e0e8f54b, 0x1b27862b1c01f247},
+	{0x5528c11f1a53f76f, 0x2f52d1bc1667f506},
+	{0x44209a7f48432c59, 0x0c424163451ff738},
+	{0x6d00f7320d3846f4, 0x7a039bd208332526},
+	{0x5733f8f4d76038c3, 0x7b361641a028ea85},
+	{0x45c32d90ac4cfa36, 0x2f5e78348020bb9e},
+	{0x6f9eaf4de07b29f0, 0x4bca59ed99cdf8fc},
+	{0x594bbf71806287f3, 0x563b7b247b0b2d96},
+	{0x476fcc5acd1b9ff6, 0x11c92f50626f57ac},
+	{0x724c7a2ae1c5ccbd, 0x02db7ee703e55912},
+	{0x5b7061bbe7d17097, 0x1be2cbec031de0dc},
+	{0x4926b496530df3ac, 0x164f09899c17e716},
+	{0x750aba8a1e7cb913, 0x3d4b4275c68ca4f0},
+	{0x5da22ed4e530940f, 0x4aa29b916ba3b726},
+	{0x4ae825771dc07672, 0x6ee87c74561c9285},
+	{0x77d9d58b62cd8a51, 0x3173fa53bcfa8408},
+	{0x5fe177a2b5713b74, 0x278ffb7630c869a0},
+	{0x4cb45fb55df42f90, 0x1fa662c4f3d387b3},
+	{0x7aba32bbc986b280, 0x32a3d13b1fb8d91f},
+	{0x622e8efca1388ecd, 0x0ee9742f4c93e0e6},
+	{0x4e8ba596e760723d, 0x58bac3590a0fe71e},
+	{0x7dac3c24a5671d2f, 0x412ad228101971c9},
+	{0x6489c9b6eab8e426, 0x00ef0e8673478e3b},
+	{0x506e3af8bbc71ceb, 0x1a58d86b8f6c71c9},
+	{0x40582f2d6305b0bc, 0x1513e0560c56c16e},
+	{0x66f37eaf04d5e793, 0x3b530089ad579be2},
+	{0x525c6558d0ab1fa9, 0x15dc006e2446164f},
+	{0x41e384470d55b2ed, 0x5e4999f1b69e783f},
+	{0x696c06d81555eb15, 0x7d428fe92430c065},
+	{0x54566be0111188de, 0x31020cba835a3384},
+	{0x4378564cda746d7e, 0x5a680a2ecf7b5c69},
+	{0x6bf3bd47c3ed7bfd, 0x770cdd17b25efa42},
+	{0x565c976c9cbdfccb, 0x1270b0dfc1e59502},
+	{0x4516df8a16fe63d5, 0x5b8d5a4c9b1e10ce},
+	{0x6e8aff4357fd6c89, 0x127bc3adc4fce7b0},
+	{0x586f329c466456d4, 0x0ec96957d0ca52f3},
+	{0x46bf5bb038504576, 0x3f07877973d50f29},
+	{0x71322c4d26e6d58a, 0x31a5a58f1fbb4b75},
+	{0x5a8e89d75252446e, 0x5aeaead8e62f6f91},
+	{0x487207df750e9d25, 0x2f22557a51bf8c74},
+	{0x73e9a63254e42ea2, 0x1836ef2a1c65ad86},
+	{0x5cbaeb5b771cf21b, 0x2cf8bf54e3848ad2},
+	{0x4a2f22af927d8e7c, 0x23fa32aa4f9d3bdb},
+	{0x76b1d118ea627d93, 0x5329eaaa18fb92f8},
+	{0x5ef4a74721e86476, 0x0f54bbbb472fa8c6},
+	{0x4bf6ec38e7ed1d2b, 0x25dd62fc38f2ed6c},
+	{0x798b138e3fe1c845, 0x22fbd1938e517bdf},
+	{0x613c0fa4ffe7d36a, 0x4f2fdadc71dac97f},
+	{0x4dc9a61d998642bb, 0x58f3157d27e23acc},
+	{0x7c75d695c2706ac5, 0x74b82261d969f7ad},
+	{0x63917877cec0556b, 0x10934eb4adee5fbe},
+	{0x4fa793930bcd1122, 0x4075d8908b251965},
+	{0x7f7285b812e1b504, 0x00bc8db411d4f56e},
+	{0x65f537c675815d9c, 0x66fd3e29a7dd9125},
+	{0x5190f96b91344ae3, 0x6bfdcb54864ada84},
+	{0x4140c78940f6a24f, 0x6ffe3c439ea2486a},
+	{0x6867a5a867f103b2, 0x7ffd2d38fdd073dc},
+	{0x53861e2053273628, 0x6664242d97d9f64a},
+	{0x42d1b1b375b8f820, 0x51e9b68adfe191d5},
+	{0x6ae91c5255f4c034, 0x1ca924116635b621},
+	{0x558749db77f70029, 0x63ba83411e915e81},
+	{0x446c3b15f9926687, 0x6962029a7edab201},
+	{0x6d79f82328ea3da6, 0x0f03375d97c45001},
+	{0x5794c6828721caeb, 0x259c2c4adfd04001},
+	{0x46109eced2816f22, 0x5149bd08b30d0001},
+	{0x701a97b150cf1837, 0x3542c80deb480001},
+	{0x59aedfc10d7279c5, 0x7768a00b22a00001},
+	{0x47bf19673df52e37, 0x79208008e8800001},
+	{0x72cb5bd86321e38c, 0x5b67334174000001},
+	{0x5bd5e313828182d6, 0x7c528f6790000001},
+	{0x4977e8dc68679bdf, 0x16a872b940000001},
+	{0x758ca7c70d7292fe, 0x5773eac200000001},
+	{0x5e0a1fd271287598, 0x45f6556800000001},
+	{0x4b3b4ca85a86c47a, 0x04c5112000000001},
+	{0x785ee10d5da46d90, 0x07a1b50000000001},
+	{0x604be73de4838ad9, 0x52e7c40000000001},
+	{0x4d0985cb1d3608ae, 0x0f1fd00000000001},
+	{0x7b426fab61f00de3, 0x31cc800000000001},
+	{0x629b8c891b267182, 0x5b0a000000000001},
+	{0x4ee2d6d415b85ace, 0x7c08000000000001},
+	{0x7e37be2022c0914b, 0x1340000000000001},
+	{0x64f964e68233a76f, 0x2900000000000001},
+	{0x50c783eb9b5c85f2, 0x5400000000000001},
+	{0x409f9cbc7c4a04c2, 0x1000000000000001},
+	{0x6765c793fa10079d, 0x0000000000000001},
+	{0x52b7d2dcc80cd2e4, 0x0000000000000001},
+	{0x422ca8b0a00a4250, 0x0000000000000001},
+	{0x69e10de76676d080, 0x0000000000000001},
+	{0x54b40b1f852bda00, 0x0000000000000001},
+	{0x43c33c1937564800, 0x0000000000000001},
+	{0x6c6b935b8bbd4000, 0x0000000000000001},
+	{0x56bc75e2d6310000, 0x0000000000000001},
+	{0x4563918244f40000, 0x0000000000000001},
+	{0x6f05b59d3b200000, 0x0000000000000001},
+	{0x58d15e1762800000, 0x0000000000000001},
+	{0x470de4df82000000, 0x0000000000000001},
+	{0x71afd498d0000000, 0x0000000000000001},
+	{0x5af3107a40000000, 0x0000000000000001},
+	{0x48c2739500000000, 0x0000000000000001},
+	{0x746a528800000000, 0x0000000000000001},
+	{0x5d21dba000000000, 0x0000000000000001},
+	{0x4a817c8000000000, 0x0000000000000001},
+	{0x7735940000000000, 0x0000000000000001},
+	{0x5f5e100000000000, 0x0000000000000001},
+	{0x4c4b400000000000, 0x0000000000000001},
+	{0x7a12000000000000, 0x0000000000000001},
+	{0x61a8000000000000, 0x0000000000000001},
+	{0x4e20000000000000, 0x0000000000000001},
+	{0x7d00000000000000, 0x0000000000000001},
+	{0x6400000000000000, 0x0000000000000001},
+	{0x5000000000000000, 0x0000000000000001},
+	{0x4000000000000000, 0x0000000000000001},
+	{0x6666666666666666, 0x3333333333333334},
+	{0x51eb851eb851eb85, 0x0f5c28f5c28f5c29},
+	{0x4189374bc6a7ef9d, 0x5916872b020c49bb},
+	{0x68db8bac710cb295, 0x74f0d844d013a92b},
+	{0x53e2d6238da3c211, 0x43f3e0370cdc8755},
+	{0x431bde82d7b634da, 0x698fe69270b06c44},
+	{0x6b5fca6af2bd215e, 0x0f4ca41d811a46d4},
+	{0x55e63b88c230e77e, 0x3f70834acdae9f10},
+	{0x44b82fa09b5a52cb, 0x4c5a02a23e254c0d},
+	{0x6df37f675ef6eadf, 0x2d5cd10396a21347},
+	{0x57f5ff85e592557f, 0x3de3da69454e75d3},
+	{0x465e6604b7a84465, 0x7e4fe1edd10b9175},
+	{0x709709a125da0709, 0x4a19697c81ac1bef},
+	{0x5a126e1a84ae6c07, 0x54e1213067bce326},
+	{0x480ebe7b9d58566c, 0x43e74dc052fd8285},
+	{0x734aca5f6226f0ad, 0x530baf9a1e626a6d},
+	{0x5c3bd5191b525a24, 0x426fbfae7eb521f1},
+	{0x49c97747490eae83, 0x4ebfcc8b9890e7f4},
+	{0x760f253edb4ab0d2, 0x4acc7a78f41b0cba},
+	{0x5e72843249088d75, 0x223d2ec729af3d62},
+	{0x4b8ed0283a6d3df7, 0x34fdbf05baf29781},
+	{0x78e480405d7b9658, 0x54c931a2c4b758cf},
+	{0x60b6cd004ac94513, 0x5d6dc14f03c5e0a5},
+	{0x4d5f0a66a23a9da9, 0x31249aa59c9e4d51},
+	{0x7bcb43d769f762a8, 0x4ea0f76f60fd4882},
+	{0x63090312bb2c4eed, 0x254d92bf80caa068},
+	{0x4f3a68dbc8f03f24, 0x1dd7a89933d54d20},
+	{0x7ec3daf941806506, 0x62f2a75b86221500},
+	{0x65697bfa9acd1d9f, 0x025bb91604e810cd},
+	{0x51212ffbaf0a7e18, 0x684960de6a5340a4},
+	{0x40e7599625a1fe7a, 0x203ab3e521dc33b6},
+	{0x67d88f56a29cca5d, 0x19f7863b696052bd},
+	{0x5313a5dee87d6eb0, 0x7b2c6b62bab37564},
+	{0x42761e4bed31255a, 0x2f56bc4efbc2c450},
+	{0x6a5696dfe1e83bc3, 0x655793b192d13a1a},
+	{0x5512124cb4b9c969, 0x377942f475742e7b},
+	{0x440e750a2a2e3aba, 0x5f9435905df68b96},
+	{0x6ce3ee76a9e3912a, 0x65b9ef4d63241289},
+	{0x571cbec554b60dbb, 0x6afb25d782834207},
+	{0x45b0989ddd5e7163, 0x08c8eb12cecf6806},
+	{0x6f80f42fc8971bd1, 0x5adb11b7b14bd9a3},
+	{0x5933f68ca078e30e, 0x157c0e2c8dd647b5},
+	{0x475cc53d4d2d8271, 0x5dfcd823a4ab6c91},
+	{0x722e086215159d82, 0x632e269f6ddf141b},
+	{0x5b5806b4ddaae468, 0x4f581ee5f17f4349},
+	{0x49133890b1558386, 0x72ace584c1329c3b},
+	{0x74eb8db44eef38d7, 0x6aae3c079b842d2a},
+	{0x5d893e29d8bf60ac, 0x5558300616035755},
+	{0x4ad431bb13cc4d56, 0x7779c004de6912ab},
+	{0x77b9e92b52e07bbe, 0x258f99a163db5111},
+	{0x5fc7edbc424d2fcb, 0x37a614811caf740d},
+	{0x4c9ff163683dbfd5, 0x7951aa00e3bf900b},
+	{0x7a998238a6c932ef, 0x754f7667d2cc19ab},
+	{0x6214682d523a8f26, 0x2aa5f8530f09ae22},
+	{0x4e76b9bddb620c1e, 0x55519375a5a1581b},
+	{0x7d8ac2c95f034697, 0x3bb5b8bc3c3559c5},
+	{0x646f023ab2690545, 0x7c9160969691149e},
+	{0x5058ce955b87376b, 0x16dab3ababa743b2},
+	{0x40470baaaf9f5f88, 0x78aef622efb902f5},
+	{0x66d812aab29898db, 0x0de4bd04b2c19e54},
+	{0x524675555bad4715, 0x57ea30d08f014b76},
+	{0x41d1f7777c8a9f44, 0x4654f3da0c01092c},
+	{0x694ff258c7443207, 0x23bb1fc346680eac},
+	{0x543ff513d29cf4d2, 0x4fc8e635d1ecd88a},
+	{0x43665da9754a5d75, 0x263a51c4a7f0ad3b},
+	{0x6bd6fc425543c8bb, 0x56c3b607731aaec4},
+	{0x5645969b77696d62, 0x789c919f8f488bd0},
+	{0x4504787c5f878ab5, 0x46e3a7b2d906d640},
+	{0x6e6d8d93cc0c1122, 0x3e390c515b3e239a},
+	{0x5857a4763cd6741b, 0x4b60d6a77c31b615},
+	{0x46ac8391ca4529af, 0x55e7121f968e2b44},
+	{0x711405b6106ea919, 0x0971b698f0e3786d},
+	{0x5a766af80d255414, 0x078e2bad8d82c6bd},
+	{0x485ebbf9a41ddcdc, 0x6c71bc8ad79bd231},
+	{0x73cac65c39c96161, 0x2d82c7448c2c8382},
+	{0x5ca23849c7d44de7, 0x3e023903a356cf9b},
+	{0x4a1b603b06437185, 0x7e682d9c82abd949},
+	{0x76923391a39f1c09, 0x4a4048fa6aac8edb},
+	{0x5edb5c7482e5b007, 0x55003a61eef07249},
+	{0x4be2b05d35848cd2, 0x773361e7f259f507},
+	{0x796ab3c855a0e151, 0x3eb89ca6508fee71},
+	{0x6122296d114d810d, 0x7efa16eb73a6585b},
+	{0x4db4edf0daa4673e, 0x3261abef8fb846af},
+	{0x7c54afe7c43a3eca, 0x1d691318e5f3a44b},
+	{0x6376f31fd02e98a1, 0x64540f471e5c836f},
+	{0x4f925c1973587a1b, 0x0376729f4b7d35f3},
+	{0x7f50935bebc0c35e, 0x38bd84321261efeb},
+	{0x65da0f7cbc9a35e5, 0x13cad0280eb4bfef},
+	{0x517b3f96fd482b1d, 0x5ca240200bc3ccbf},
+	{0x412f66126439bc17, 0x63b50019a3030a33},
+	{0x684bd683d38f9359, 0x1f88002904d1a9ea},
+	{0x536fdecfdc72dc47, 0x32d3335403daee55},
+	{0x42bfe57316c249d2, 0x5bdc291003158b77},
+	{0x6acca251be03a951, 0x12f9db4cd1bc1258},
+	{0x557081dafe695440, 0x7594af70a7c9a847},
+	{0x445a017bfebaa9cd, 0x4476f2c0863aed06},
+	{0x6d5ccf2ccac442e2, 0x3a57eacda3917b3c},
+	{0x577d728a3bd03581, 0x7b7988a482dac8fd},
+	{0x45fdf53b630cf79b, 0x15fad3b6cf156d97},
+	{0x6ffcbb923814bf5e, 0x565e1f8ae4ef15be},
+	{0x5996fc74f9aa32b2, 0x11e4e608b725aaff},
+	{0x47abfd2a6154f55b, 0x27ea51a0928488cc},
+	{0x72acc843ceee555e, 0x7310829a84074146},
+	{0x5bbd6d030bf1dde5, 0x42739baed005cdd2},
+	{0x49645735a327e4b7, 0x4ec2e2f24004a4a8},
+	{0x756d5855d1d96df2, 0x4ad16b1d333aa10c},
+	{0x5df11377db1457f5, 0x2241227dc2954da3},
+	{0x4b2742c648dd132a, 0x4e9a81fe35443e1c},
+	{0x783ed13d4161b844, 0x175d9cc9eed39694},
+	{0x603240fdcde7c69c, 0x7917b0a18bdc7876},
+	{0x4cf500cb0b1fd217, 0x1412f3b46fe39392},
+	{0x7b219ade7832e9be, 0x535185ed7fd285b6},
+	{0x628148b1f9c25498, 0x42a79e57997537c5},
+	{0x4ecdd3c1949b76e0, 0x3552e512e12a9304},
+	{0x7e161f9c20f8be33, 0x6eeb081e3510eb39},
+	{0x64de7fb01a609829, 0x3f226ce4f740bc2e},
+	{0x50b1ffc0151a1354, 0x3281f0b72c33c9be},
+	{0x408e66334414dc43, 0x42018d5f568fd498},
+	{0x674a3d1ed354939f, 0x1ccf48988a7fba8d},
+	{0x52a1ca7f0f76dc7f, 0x30a5d3ad3b99620b},
+	{0x421b0865a5f8b065, 0x73b7dc8a96144e6f},
+	{0x69c4da3c3cc11a3c, 0x52bfc7442353b0b1},
+	{0x549d7b6363cdae96, 0x756639034f7626f4},
+	{0x43b12f82b63e2545, 0x4451c735d92b525d},
+	{0x6c4eb26abd303ba2, 0x3a1c71efc1deea2e},
+	{0x56a55b889759c94e, 0x61b05b2634b254f2},
+	{0x45511606df7b0772, 0x1af37c1e908eaa5b},
+	{0x6ee8233e325e7250, 0x2b1f2cfdb41776f8},
+	{0x58b9b5cb5b7ec1d9, 0x6f4c23fe29ac5f2d},
+	{0x46faf7d5e2cbce47, 0x72a34ffe87bd18f1},
+	{0x71918c896adfb073, 0x04387ffda5fb5b1b},
+	{0x5adad6d4557fc05c, 0x0360666484c915af},
+	{0x48af1243779966b0, 0x02b3851d3707448c},
+	{0x744b506bf28f0ab3, 0x1dec082ebe720746},
+	{0x5d090d2328726ef5, 0x64bcd358985b3905},
+	{0x4a6da41c205b8bf7, 0x6a30a913ad15c738},
+	{0x7715d36033c5acbf, 0x5d1aa81f7b560b8c},
+	{0x5f44a919c3048a32, 0x7daeece5fc44d609},
+	{0x4c36edae359d3b5b, 0x7e258a51969d7808},
+	{0x79f17c49ef61f893, 0x16a276e8f0fbf33f},
+	{0x618dfd07f2b4c6dc, 0x121b9253f3fcc299},
+	{0x4e0b30d328909f16, 0x41afa84329970214},
+	{0x7cdeb4850db431bd, 0x4f7f739ea8f19ced},
+	{0x63e55d373e29c164, 0x3f99294bba5ae3f1},
+	{0x4feab0f8fe87cde9, 0x7fadbaa2fb7be98d},
+	{0x7fdde7f4ca72e30f, 0x7f7c5dd1925fdc15},
+	{0x664b1ff7085be8d9, 0x4c637e4141e649ab},
+	{0x51d5b32c06afed7a, 0x704f983434b83aef},
+	{0x4177c2899ef32462, 0x26a6135cf6f9c8bf},
+	{0x68bf9da8fe51d3d0, 0x3dd685618b294132},
+	{0x53cc7e20cb74a973, 0x4b12044e08edcdc2},
+	{0x4309fe80a2c3bac2, 0x6f419d0b3a57d7ce},
+	{0x6b4330cdd1392ad1, 0x320294dec3bfbfb0},
+	{0x55cf5a3e40fa88a7, 0x419baa4bcfcc995a},
+	{0x44a5e1cb672ed3b9, 0x1ae2eea30ca3ade1},
+	{0x6dd636123eb152c1, 0x77d17dd1add2afcf},
+	{0x57de91a832277567, 0x797464a7be42263f},
+	{0x464ba7b9c1b92ab9, 0x4790508631ce84ff},
+	{0x70790c5c6928445c, 0x0c1a1a704fb0d4cc},
+	{0x59fa7049edb9d049, 0x567b4859d95a43d6},
+	{0x47fb8d07f161736e, 0x11fc39e17aae9cab},
+	{0x732c14d98235857d, 0x032d2968c44a9445},
+	{0x5c2343e134f79dfd, 0x4f575453d03ba9d1},
+	{0x49b5cfe75d92e4ca, 0x72ac4376402fbb0e},
+	{0x75efb30bc8eb07ab, 0x0446d256cd192b49},
+	{0x5e595c096d88d2ef, 0x1d0575123dadbc3a},
+	{0x4b7ab0078ad3dbf2, 0x4a6ac40e97be302f},
+	{0x78c44cd8de1fc650, 0x771139b0f2c9e6b1},
+	{0x609d0a4718196b73, 0x78da948d8f07ebc1},
+	{0x4d4a6e9f467abc5c, 0x60aedd3e0c065634},
+	{0x7baa4a9870c46094, 0x344afb9679a3bd20},
+	{0x62eea2138d69e6dd, 0x103bfc78614fca80},
+	{0x4f254e760abb1f17, 0x26966393810ca200},
+	{0x7ea21723445e9825, 0x2423d2859b476999},
+	{0x654e78e9037ee01d, 0x69b642047c392148},
+	{0x510b93ed9c658017, 0x6e2b680396941aa0},
+	{0x40d60ff149eaccdf, 0x71bc53361210154d},
+	{0x67bce64edcaae166, 0x1c6085235019bbae},
+	{0x52fd850be3bbe784, 0x7d1a041c40149625},
+	{0x42646a6fe9631f9d, 0x4a7b367d0010781d},
+	{0x6a3a43e642383295, 0x5d91f0c8001a59c8},
+	{0x54fb698501c68ede, 0x17a7f3d3334847d4},
+	{0x43fc546a67d20be4, 0x79532975c2a03976},
+	{0x6cc6ed770c83463b, 0x0eeb75893766c256},
+	{0x57058ac5a39c382f, 0x25892ad42c523512},
+	{0x459e089e1c7cf9bf, 0x37a0ef102374f742},
+	{0x6f6340fcfa618f98, 0x59017e8038bb2536},
+	{0x591c33fd951ad946, 0x7a67986693c8ea91},
+	{0x4749c33144157a9f, 0x151fad1edca0bba8},
+	{0x720f9eb539bbf765, 0x0832ae97c76792a5},
+	{0x5b3fb22a94965f84, 0x068ef21305ec7551},
+	{0x48ffc1bbaa11e603, 0x1ed8c1a8d189f774},
+	{0x74cc692c434fd66b, 0x4af4690e1c0ff253},
+	{0x5d705423690cab89, 0x225d20d816732843},
+	{0x4ac0434f873d5607, 0x35174d79ab8f5369},
+	{0x779a054c0b955672, 0x21bee25c45b21f0e},
+	{0x5fae6aa33c77785b, 0x3498b5169e2818d8},
+	{0x4c8b888296c5f9e2, 0x5d46f7454b534713},
+	{0x7a78da6a8ad65c9d, 0x7ba4bed545520b52},
+	{0x61fa48553bdeb07e, 0x2fb6ff110441a2a8},
+	{0x4e61d37763188d31, 0x72f8cc0d9d014eed},
+	{0x7d6952589e8daeb6, 0x1e5ae015c80217e1},
+	{0x645441e07ed7bef8, 0x1848b344a001acb4},
+	{0x504367e6cbdfcbf9, 0x603a2903b3348a2a},
+	{0x4035ecb8a3196ffb, 0x002e873628f6d4ee},
+	{0x66bcadf43828b32b, 0x19e40b89db2487e3},
+	{0x52308b29c686f5bc, 0x14b66fa17c1d3983},
+	{0x41c06f549ed25e30, 0x1091f2e7967dc79c},
+	{0x6933e554315096b3, 0x341cb7d8f0c93f5f},
+	{0x542984435aa6def5, 0x767d5fe0c0a0ff80},
+	{0x435469cf7bb8b25e, 0x2b977fe70080cc66},
+	{0x6bba42e592c11d63, 0x5f58cca4cd9ae0a3},
+	{0x562e9beadbcdb11c, 0x4c470a1d7148b3b6},
+	{0x44f216557ca48db0, 0x3d05a1b1276d5c92},
+	{0x6e5023bbfaa0e2b3, 0x7b3c35e83f1560e9},
+	{0x58401c96621a4ef6, 0x2f635e5365aab3ed},
+	{0x4699b0784e7b725e, 0x591c4b75eaeef658},
+	{0x70f5e726e3f8b6fd, 0x74fa125644b18a26},
+	{0x5a5e5285832d5f31, 0x43fb41de9d5ad4eb},
+	{0x484b75379c244c27, 0x4ffc34b2177bdd89},
+	{0x73abeebf603a1372, 0x4cc6bab68bf96274},
+	{0x5c898bcc4cfb42c2, 0x0a38955ed6611b90},
+	{0x4a07a309d72f689b, 0x21c6dde5784dafa7},
+	{0x76729e762518a75e, 0x693e2fd58d49190b},
+	{0x5ec2185e8413b918, 0x5431bfde0aa0e0d5},
+	{0x4bce79e536762dad, 0x29c1664b3bb3e711},
+	{0x794a5ca1f0bd15e2, 0x0f9bd6dec5eca4e8},
+	{0x61084a1b26fdab1b, 0x2616457f04bd50ba},
+	{0x4da03b48ebfe227c, 0x1e783798d09773c8},
+	{0x7c33920e46636a60, 0x30c058f480f252d9},
+	{0x635c74d8384f884d, 0x0d66ad9067284247},
+	{0x4f7d2a469372d370, 0x711ef14052869b6c},
+	{0x7f2eaa0a85848581, 0x34fe4ecd50d75f14},
+	{0x65beee6ed136d134, 0x2a650bd773df7f43},
+	{0x51658b8bda9240f6, 0x551da312c319329c},
+	{0x411e093caedb672b, 0x5db14f4235adc217},
+	{0x68300ec77e2bd845, 0x7c4ee536bc49368a},
+	{0x5359a56c64efe037, 0x7d0bea92303a9208},
+	{0x42ae1df050bfe693, 0x173cbba8269541a0},
+	{0x6ab02fe6e79970eb, 0x3ec792a6a422029a},
+	{0x5559bfebec7ac0bc, 0x3239421ee9b4cee1},
+	{0x4447ccbcbd2f0096, 0x5b6101b25490a581},
+	{0x6d3fadfac84b3424, 0x2bce691d541aa268},
+	{0x576624c8a03c29b6, 0x563eba7ddce21b87},
+	{0x45eb50a08030215e, 0x78322ecb171b4939},
+	{0x6fdee76733803564, 0x59e9e47824f87527},
+	{0x597f1f85c2ccf783, 0x6187e9f9b72d2a86},
+	{0x4798e6049bd72c69, 0x346cbb2e2c242205},
+	{0x728e3cd42c8b7a42, 0x20adf849e039d007},
+	{0x5ba4fd768a092e9b, 0x33be603b19c7d99f},
+	{0x4950cac53b3a8baf, 0x42feb3627b0647b3},
+	{0x754e113b91f745e5, 0x5197856a5e7072b8},
+	{0x5dd80dc941929e51, 0x27ac6abb7ec05bc6},
+	{0x4b133e3a9adbb1da, 0x52f05562cbcd1638},
+	{0x781ec9f75e2c4fc4, 0x1e4d556adfae89f3},
+	{0x6018a192b1bd0c9c, 0x7ea444557fbed4c3},
+	{0x4ce0814227ca707d, 0x4bb69d1132ff109c},
+	{0x7b00ced03faa4d95, 0x5f8a94e851981a93},
+	{0x62670bd9cc883e11, 0x32d543ed0e134875},
+	{0x4eb8d647d6d364da, 0x5bddcff0d80f6d2b},
+	{0x7df48a0c8aebd491, 0x12fc7fe7c018aeab},
+	{0x64c3a1a3a25643a7, 0x28c9ffec99ad5889},
+	{0x509c814fb511cfb9, 0x0707fff07af113a1},
+	{0x407d343fc40e3fc7, 0x1f39998d2f2742e7},
+	{0x672eb9ffa016cc71, 0x7ec28f484b7204a4},
+	{0x528bc7ffb345705b, 0x189ba5d36f8e6a1d},
+	{0x42096ccc8f6ac048, 0x7a161e42bfa521b1},
+	{0x69a8ae1418aacd41, 0x435696d132a1cf81},
+	{0x5486f1a9ad557101, 0x1c454574288172ce},
+	{0x439f27baf1112734, 0x169dd129ba0128a5},
+	{0x6c31d92b1b4ea520, 0x242fb50f9001daa1},
+	{0x568e4755af721db3, 0x368c90d940017bb4},
+	{0x453e9f77bf8e7e29, 0x120a0d7a999ac95d},
+	{0x6eca98bf98e3fd0e, 0x50101590f5c47561},
+	{0x58a213cc7a4ffda5, 0x26734473f7d05de8},
+	{0x46e80fd6c83ffe1d, 0x6b8f69f65fd9e4b9},
+	{0x71734c8ad9fffcfc, 0x45b24323cc8fd45c},
+	{0x5ac2a3a247fffd96, 0x6af502830a0ca9e3},
+	{0x489bb61b6ccccadf, 0x08c402026e7087e9},
+	{0x742c569247ae1164, 0x746cd003e3e73fdb},
+	{0x5cf04541d2f1a783, 0x76bd73364fec3315},
+	{0x4a59d101758e1f9c, 0x5efdf5c50cbcf5ab},
+	{0x76f61b3588e365c7, 0x4b2fefa1adfb22ab},
+	{0x5f2b48f7a0b5eb06, 0x08f3261af195b555},
+	{0x4c22a0c61a2b226b, 0x20c284e25ade2aab},
+	{0x79d1013cf6ab6a45, 0x1ad0d49d5e304444},
+	{0x617400fd9222bb6a, 0x48a7107de4f369d0},
+	{0x4df6673141b562bb, 0x53b8d9fe50c2bb0d},
+	{0x7cbd71e869223792, 0x52c15cca1ad12b48},
+	{0x63cac186ba81c60e, 0x75677d6e7bda8906},
+	{0x4fd5679efb9b04d8, 0x5dec645863153a6c},
+	{0x7fbbd8fe5f5e6e27, 0x497a3a2704eec3df},
+};
+
+static const char digit_pairs[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+static inline int64_t flog10_pow2(int64_t q) {
+	return (q * 661971961083LL) >> 41;
+}
+
+static inline int64_t flog10_three_quarters_pow2(int64_t q) {
+	return (q * 661971961083LL - 274743187321LL) >> 41;
+}
+
+static inline int64_t flog2_pow10(int64_t e) {
+	return (e * 913124641741LL) >> 38;
+}
+
+/**
+ * 计算g*cp并舍入到奇数，只保留需要的高位
+ */
+static inline uint64_t round_to_odd(const uint64_t *g, uint64_t cp) {
+	uint64_t x1, y1;
+	full_mul(g[1], cp, &x1);
+	uint64_t y0 = full_mul(g[0], cp, &y1);
+	uint64_t z = (y0 >> 1) + x1;
+	uint64_t vbp = y1 + (z >> 63);
+	return vbp | (((z & (((uint64_t) 1 << 63) - 1)) + (((uint64_t) 1 << 63) - 1)) >> 63);
+}
+
+/**
+ * 求c*2^q舍入区间内最短且最接近的十进制数，返回f，指数写入e，v=f*10^e
+ */
+static uint64_t schubfach_interval(int q, uint64_t c, int *e) {
+	int out = c & 1;
+	uint64_t cb = c << 2, cbr = cb + 2, cbl;
+	int k;
+	if(c != (uint64_t) 1 << 52 || q == -1074) {
+		cbl = cb - 2;
+		k = (int) flog10_pow2(q);
+	} else {
+		cbl = cb - 1;
+		k = (int) flog10_three_quarters_pow2(q);
+	}
+	int h = q + (int) flog2_pow10(-k) + 2;
+	*e = k;
+	const uint64_t *g = schubfach_table[k - SCHUBFACH_K_MIN];
+	uint64_t vb = round_to_odd(g, cb << h), vbl = round_to_odd(g, cbl << h), vbr = round_to_odd(g, cbr << h);
+	uint64_t s = vb >> 2;
+	if(s >= 10) {
+		uint64_t sp10 = s / 10 * 10, tp10 = sp10 + 10;
+		int upin = vbl + out <= sp10 << 2, wpin = (tp10 << 2) + out <= vbr;
+		if(upin != wpin)
+			return upin ? sp10 : tp10;
+	}
+	uint64_t t = s + 1;
+	int uin = vbl + out <= s << 2, win = (t << 2) + out <= vbr;
+	if(uin != win)
+		return uin ? s : t;
+	int64_t cmp = (int64_t) (vb - ((s + t) << 1));
+	return cmp < 0 || (cmp == 0 && !(s & 1)) ? s : t;
+}
+
+/**
+ * 生成能还原出v的最短十进制数字，v=digits*10^k，v必须是正的有限数
+ */
+static int shortest_digits(double v, char *digits, int *k) {
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	int biased = (int) (bits >> 52 & 0x7FF);
+	uint64_t t = bits & (((uint64_t) 1 << 52) - 1), f;
+	int e;
+	if(biased) {
+		int mq = 1075 - biased;
+		uint64_t c = t | (uint64_t) 1 << 52;
+		if(mq > 0 && mq < 53 && (c >> mq) << mq == c) {
+			// 小整数
+			f = c >> mq;
+			e = 0;
+		} else
+			f = schubfach_interval(-mq, c, &e);
+	} else
+		f = schubfach_interval(-1074, t, &e);
+	while(f % 10 == 0) {
+		f /= 10;
+		e++;
+	}
+	char stack[24];
+	int top = sizeof(stack);
+	for(; f; f /= 10)
+		stack[--top] = '0' + f % 10;
+	memcpy(digits, stack + top, sizeof(stack) - top);
+	*k = e;
+	return sizeof(stack) - top;
+}
+
+static size_t stringify_int(char *out, long long i) {
+	char stack[24];
+	int top = sizeof(stack);
+	size_t length = 0;
+	unsigned long long u = i;
+	if(i < 0) {
+		out[length++] = '-';
+		u = 0 - u;
+	}
+	while(u >= 100) {
+		unsigned pair = (unsigned) (u % 100) * 2;
+		u /= 100;
+		stack[--top] = digit_pairs[pair + 1];
+		stack[--top] = digit_pairs[pair];
+	}
+	if(u >= 10) {
+		stack[--top] = digit_pairs[u * 2 + 1];
+		stack[--top] = digit_pairs[u * 2];
+	} else
+		stack[--top] = '0' + u;
+	memcpy(out + length, stack + top, sizeof(stack) - top);
+	return length + sizeof(stack) - top;
+}
+
+/**
+ * 输出能精确还原的最短形式，十进制指数在[-6,6]内时用定点表示，否则用d.dddE±n
+ * 至少保留一位小数，以便和整数区分
+ */
+static size_t stringify_double(char *out, double dbl) {
+	size_t length = 0;
+	if(dbl != dbl) {
+		memcpy(out, "null", 4);
+		return 4;
+	}
+	if(signbit(dbl)) {
+		out[length++] = '-';
+		dbl = -dbl;
+	}
+	if(dbl == 0) {
+		memcpy(out + length, "0.0", 3);
+		return length + 3;
+	}
+	if(dbl > DBL_MAX) {
+		memcpy(out + length, "1E400", 5);
+		return length + 5;
+	}
+	char digits[24];
+	int k, count = shortest_digits(dbl, digits, &k), e = count + k - 1;
+	if(e >= 0 && e <= 6) {
+		if(count <= e + 1) {
+			memcpy(out + length, digits, count);
+			memset(out + length + count, '0', e + 1 - count);
+			length += e + 1;
+			memcpy(out + length, ".0", 2);
+			return length + 2;
+		}
+		memcpy(out + length, digits, e + 1);
+		length += e + 1;
+		out[length++] = '.';
+		memcpy(out + length, digits + e + 1, count - e - 1);
+		return length + count - e - 1;
+	}
+	if(e < 0 && e >= -6) {
+		memcpy(out + length, "0.", 2);
+		memset(out + length + 2, '0', -e - 1);
+		length += 2 - e - 1;
+		memcpy(out + length, digits, count);
+		return length + count;
+	}
+	out[length++] = digits[0];
+	out[length++] = '.';
+	if(count == 1) {
+		out[length++] = '0';
+	} else {
+		memcpy(out + length, digits + 1, count - 1);
+		length += count - 1;
+	}
+	out[length++] = 'E';
+	return length + stringify_int(out + length, e);
+}
+
+/**
+ * 没有原始文本的数字按数值格式化，out至少要有64字节
+ */
+static size_t format_number(struct _cave_jsonc_number *num, char *out) {
+	if(num->flag & CAVE_JSONC_NUM_IVAL)
+		return stringify_int(out, num->ival);
+	return stringify_double(out, num->fval);
+}
+
+cave_jsonc_string cave_jsonc_get_raw_number(cave_jsonc_value value) {
+	struct _cave_jsonc_number *num = &value->value.number;
+	if(!(num->flag & CAVE_JSONC_NUM_RAW)) {
+		char head[64];
+		size_t length = format_number(num, head);
+		num->raw = alloc_string(value->document, head, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+		num->flag |= CAVE_JSONC_NUM_RAW;
+	}
+	return num->raw;
+}
+
+int cave_jsonc_print_error_full(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file,
+		const char *filename, int (*fseek)(void *, size_t, int), int (*fgetc)(void *file), void *in) {
+	cave_jsonc_error err = doc->error_head;
+	char head[100];
+	size_t count = 0;
+	while(err) {
+		if(err->position.row > 0 && err->position.cols > 0) {
+			ffputs(fputc, file, filename);
+			if(err->fatal > 0)
+				sprintf(head, ":%ld:%ld: 错误: ", err->position.row, err->position.cols);
+			else if(err->fatal == 0)
+				sprintf(head, ":%ld:%ld: 警告: ", err->position.row, err->position.cols);
+			else
+				sprintf(head, ":%ld:%ld: 信息: ", err->position.row, err->position.cols);
+			ffputs(fputc, file, head);
+			ffputs(fputc, file, err->message);
+			fputc('\n', file);
+			fseek(in, err->position.index - err->position.cols + 1, SEEK_SET);
+			int out = 0, p = 1;
+			while(out != '\n' && out >= 0) {
+				fputc(out, file);
+				if(p == err->position.cols - 1)
+					ffputs(fputc, file, " !!这里!! ->> ");
+				p++;
+				out = fgetc(in);
+			}
+			fputc('\n', file);
+			fputc('\n', file);
+		} else {
+			if(err->fatal > 0)
+				ffputs(fputc, file, "<未知>: 错误: ");
+			else if(err->fatal == 0)
+				ffputs(fputc, file, "<未知>: 警告: ");
+			else
+				ffputs(fputc, file, "<未知>: 信息: ");
+			ffputs(fputc, file, err->message);
+			ffputs(fputc, file, "\n\t<无源代码>\n\n");
+		}
+		count += err->fatal >= 0;
+		err = err->next;
+	}
+	if(count) {
+		sprintf(head, "共 %ld 个错误或警告\n", count);
+		ffputs(fputc, file, head);
+	}
+	return count;
+}
+
+void cave_jsonc_warn_value(cave_jsonc_value value, const char *message, int fatal) {
+	cave_jsonc_report_error(value->document, message, value->position, fatal);
+}
+
+void cave_jsonc_warn_key(cave_jsonc_kvpair pair, const char *message, int fatal) {
+	cave_jsonc_report_error(pair->object->value->document, message, pair->position, fatal);
+}
+
+/**
+ * 磁带中每个条目的高8位是标签，低56位是附加值
+ * 数字占两个条目，第二个条目是数值本身
+ * 容器开始条目的附加值是容器之后第一个条目的下标，结束条目的附加值是成员个数
+ * 字符串条目的附加值是字符串在strings中的偏移，那里依次存放长度、内容和\0
+ * 第0个条目是磁带头，根节点从第1个条目开始
+ */
+enum tape_tag {
+	TAPE_ROOT,
+	TAPE_NULL,
+	TAPE_TRUE,
+	TAPE_FALSE,
+	TAPE_INTEGER,
+	TAPE_DOUBLE,
+	TAPE_STRING,
+	TAPE_OBJECT,
+	TAPE_OBJECT_END,
+	TAPE_ARRAY,
+	TAPE_ARRAY_END,
+};
+
+#define TAPE_PAYLOAD_MASK ((UINT64_C(1) << 56) - 1)
+#define TAPE_ENTRY(tag, payload) ((uint64_t) (tag) << 56 | (payload))
+#define TAPE_TAG(entry) ((int) ((entry) >> 56))
+#define TAPE_PAYLOAD(entry) ((entry) & TAPE_PAYLOAD_MASK)
+
+struct _cave_jsonc_tape {
+	uint64_t *entries;
+	size_t size, cap;
+	char *strings;
+	size_t strings_size, strings_cap;
+	/**
+	 * 保存解析时的错误
+	 */
+	cave_jsonc_document doc;
+	/**
+	 * 构建时还没有结束的容器的开始条目
+	 */
+	size_t *open;
+	size_t depth, open_cap;
+	/**
+	 * 从映像映射的磁带，entries和strings指向映射，不能修改
+	 */
+	void *mapping;
+	size_t mapping_length;
+	/**
+	 * 成员较多的容器的查找表，格式见build_tape_index，映射的磁带指向映像中的查找表
+	 */
+	uint64_t *index;
+	size_t index_size;
+};
+
+static void build_tape_index(cave_jsonc_tape tape);
+
+static size_t tape_put(cave_jsonc_tape tape, uint64_t entry) {
+	if(tape->size == tape->cap) {
+		tape->cap *= 2;
+		tape->entries = realloc(tape->entries, sizeof(uint64_t) * tape->cap);
+	}
+	tape->entries[tape->size] = entry;
+	return tape->size++;
+}
+
+/**
+ * 每个值都是所在容器的一个成员，对象的成员在键出现时计数
+ */
+static void tape_count(cave_jsonc_tape tape) {
+	if(tape->depth)
+		tape->entries[tape->open[tape->depth - 1]]++;
+}
+
+/**
+ * 数组中的值计入数组的成员个数，对象中的值已经随键计数
+ */
+static void tape_value(cave_jsonc_tape tape) {
+	if(tape->depth && TAPE_TAG(tape->entries[tape->open[tape->depth - 1]]) == TAPE_ARRAY)
+		tape_count(tape);
+}
+
+static int tape_start(cave_jsonc_tape tape, int tag) {
+	if(tape->depth == tape->open_cap) {
+		tape->open_cap = tape->open_cap ? tape->open_cap * 2 : 16;
+		tape->open = realloc(tape->open, sizeof(size_t) * tape->open_cap);
+	}
+	tape_value(tape);
+	tape->open[tape->depth++] = tape_put(tape, TAPE_ENTRY(tag, 0));
+	return 0;
+}
+
+static int tape_end(cave_jsonc_tape tape, int tag) {
+	size_t start = tape->open[--tape->depth];
+	uint64_t count = TAPE_PAYLOAD(tape->entries[start]);
+	tape_put(tape, TAPE_ENTRY(tag, count));
+	tape->entries[start] = TAPE_ENTRY(TAPE_TAG(tape->entries[start]), tape->size);
+	return 0;
+}
+
+static void tape_string(cave_jsonc_tape tape, const char *value, size_t length) {
+	size_t need = tape->strings_size + sizeof(size_t) + length + 1;
+	if(need > tape->strings_cap) {
+		while(need > tape->strings_cap)
+			tape->strings_cap *= 2;
+		tape->strings = realloc(tape->strings, tape->strings_cap);
+	}
+	tape_put(tape, TAPE_ENTRY(TAPE_STRING, tape->strings_size));
+	char *p = tape->strings + tape->strings_size;
+	memcpy(p, &length, sizeof(size_t));
+	memcpy(p + sizeof(size_t), value, length);
+	p[sizeof(size_t) + length] = '\0';
+	tape->strings_size = need;
+}
+
+static int tape_start_object(void *user, cave_jsonc_position position) {
+	(void) position;
+	return tape_start(user, TAPE_OBJECT);
+}
+
+static int tape_end_object(void *user) {
+	return tape_end(user, TAPE_OBJECT_END);
+}
+
+static int tape_start_array(void *user, cave_jsonc_position position) {
+	(void) position;
+	return tape_start(user, TAPE_ARRAY);
+}
+
+static int tape_end_array(void *user) {
+	return tape_end(user, TAPE_ARRAY_END);
+}
+
+static int tape_key(void *user, const char *key, size_t length, cave_jsonc_position position) {
+	(void) position;
+	tape_count(user);
+	tape_string(user, key, length);
+	return 0;
+}
+
+static int tape_string_value(void *user, const char *value, size_t length, cave_jsonc_position position) {
+	(void) position;
+	tape_value(user);
+	tape_string(user, value, length);
+	return 0;
+}
+
+static int tape_number(void *user, const cave_jsonc_sax_number *number, cave_jsonc_position position) {
+	(void) position;
+	tape_value(user);
+	if(number->integer) {
+		tape_put(user, TAPE_ENTRY(TAPE_INTEGER, 0));
+		tape_put(user, (uint64_t) number->ival);
+	} else {
+		uint64_t bits;
+		memcpy(&bits, &number->fval, sizeof(bits));
+		tape_put(user, TAPE_ENTRY(TAPE_DOUBLE, 0));
+		tape_put(user, bits);
+	}
+	return 0;
+}
+
+static int tape_boolean(void *user, int value, cave_jsonc_position position) {
+	(void) position;
+	tape_value(user);
+	tape_put(user, TAPE_ENTRY(value ? TAPE_TRUE : TAPE_FALSE, 0));
+	return 0;
+}
+
+static int tape_null(void *user, cave_jsonc_position position) {
+	(void) position;
+	tape_value(user);
+	tape_put(user, TAPE_ENTRY(TAPE_NULL, 0));
+	return 0;
+}
+
+static const cave_jsonc_sax_handler tape_handler = {
+	tape_start_object, tape_end_object, tape_start_array, tape_end_array,
+	tape_key, tape_string_value, tape_number, tape_boolean, tape_null,
+};
+
+static cave_jsonc_tape alloc_tape() {
+	cave_jsonc_tape tape = calloc(1, sizeof(struct _cave_jsonc_tape));
+	tape->cap = 256;
+	tape->entries = malloc(sizeof(uint64_t) * tape->cap);
+	tape->strings_cap = 256;
+	tape->strings = malloc(tape->strings_cap);
+	tape_put(tape, TAPE_ENTRY(TAPE_ROOT, 0));
+	return tape;
+}
+
+/**
+ * 解析结束后收回多余的空间，出错时丢弃不完整的内容，只保留磁带头
+ */
+static cave_jsonc_tape finish_tape(cave_jsonc_tape tape, cave_jsonc_document doc) {
+	tape->doc = doc;
+	if(cave_jsonc_has_fatal_error(doc))
+		tape->size = 1;
+	tape->entries[0] = TAPE_ENTRY(TAPE_ROOT, tape->size);
+	tape->entries = realloc(tape->entries, sizeof(uint64_t) * tape->size);
+	tape->cap = tape->size;
+	if(tape->size == 1)
+		tape->strings_size = 0;
+	tape->strings = realloc(tape->strings, tape->strings_size ? tape->strings_size : 1);
+	tape->strings_cap = tape->strings_size;
+	free(tape->open);
+	tape->open = NULL;
+	tape->depth = tape->open_cap = 0;
+	build_tape_index(tape);
+	return tape;
+}
+
+cave_jsonc_tape cave_jsonc_parser_parse_tape(cave_jsonc_parser ps, int (*fgetc)(void *file), void *file) {
+	cave_jsonc_tape tape = alloc_tape();
+	return finish_tape(tape, cave_jsonc_parser_parse_events(ps, fgetc, file, &tape_handler, tape));
+}
+
+cave_jsonc_tape cave_jsonc_parser_parse_buffer_tape(cave_jsonc_parser ps, const char *data, size_t length) {
+	cave_jsonc_tape tape = alloc_tape();
+	return finish_tape(tape, cave_jsonc_parser_parse_buffer_events(ps, data, length, &tape_handler, tape));
+}
+
+cave_jsonc_tape cave_jsonc_parse_tape(int (*fgetc)(void *file), void *file) {
+	cave_jsonc_tape tape = alloc_tape();
+	return finish_tape(tape, cave_jsonc_parse_events(fgetc, file, &tape_handler, tape));
+}
+
+cave_jsonc_tape cave_jsonc_parse_buffer_tape(const char *data, size_t length) {
+	cave_jsonc_tape tape = alloc_tape();
+	return finish_tape(tape, cave_jsonc_parse_buffer_events(data, length, &tape_handler, tape));
+}
+
+void cave_jsonc_release_tape(cave_jsonc_tape tape) {
+	cave_jsonc_release_document(tape->doc);
+	if(tape->mapping) {
+		munmap(tape->mapping, tape->mapping_length);
+	} else {
+		free(tape->entries);
+		free(tape->strings);
+		free(tape->index);
+	}
+	free(tape);
+}
+
+cave_jsonc_document cave_jsonc_get_tape_document(cave_jsonc_tape tape) {
+	return tape->doc;
+}
+
+cave_jsonc_tape_value cave_jsonc_get_tape_root(cave_jsonc_tape tape) {
+	// 出错时磁带只有磁带头，根节点不存在
+	return (cave_jsonc_tape_value) {tape, tape->size > 1 ? 1 : 0};
+}
+
+static inline uint64_t tape_entry(cave_jsonc_tape_value value) {
+	return value.tape->entries[value.index];
+}
+
+/**
+ * 跳过一个值，返回它之后第一个条目的下标
+ */
+static size_t tape_skip(cave_jsonc_tape_value value) {
+	uint64_t entry = tape_entry(value);
+	switch(TAPE_TAG(entry)) {
+		case TAPE_INTEGER:
+		case TAPE_DOUBLE:
+			return value.index + 2;
+		case TAPE_OBJECT:
+		case TAPE_ARRAY:
+			return TAPE_PAYLOAD(entry);
+		default:
+			return value.index + 1;
+	}
+}
+
+/**
+ * 下标处是容器的结束条目时返回不存在的值
+ */
+static cave_jsonc_tape_value tape_member(cave_jsonc_tape tape, size_t index) {
+	int tag = TAPE_TAG(tape->entries[index]);
+	if(tag == TAPE_OBJECT_END || tag == TAPE_ARRAY_END)
+		index = 0;
+	return (cave_jsonc_tape_value) {tape, index};
+}
+
+cave_jsonc_type cave_jsonc_get_tape_value_type(cave_jsonc_tape_value value) {
+	if(!value.index)
+		return CAVE_JSONC_UNDEFINED;
+	switch(TAPE_TAG(tape_entry(value))) {
+		case TAPE_NULL:
+			return CAVE_JSONC_NULL;
+		case TAPE_TRUE:
+		case TAPE_FALSE:
+			return CAVE_JSONC_BOOLEAN;
+		case TAPE_INTEGER:
+		case TAPE_DOUBLE:
+			return CAVE_JSONC_NUMBER;
+		case TAPE_STRING:
+			return CAVE_JSONC_STRING;
+		case TAPE_OBJECT:
+			return CAVE_JSONC_OBJECT;
+		case TAPE_ARRAY:
+			return CAVE_JSONC_ARRAY;
+		default:
+			return CAVE_JSONC_UNDEFINED;
+	}
+}
+
+int cave_jsonc_get_tape_boolean(cave_jsonc_tape_value value) {
+	return TAPE_TAG(tape_entry(value)) == TAPE_TRUE;
+}
+
+long long cave_jsonc_get_tape_integer(cave_jsonc_tape_value value) {
+	uint64_t bits = value.tape->entries[value.index + 1];
+	if(TAPE_TAG(tape_entry(value)) == TAPE_INTEGER)
+		return (long long) bits;
+	double fval;
+	memcpy(&fval, &bits, sizeof(fval));
+	return double_to_integer(fval);
+}
+
+double cave_jsonc_get_tape_double(cave_jsonc_tape_value value) {
+	uint64_t bits = value.tape->entries[value.index + 1];
+	if(TAPE_TAG(tape_entry(value)) == TAPE_INTEGER)
+		return (double) (long long) bits;
+	double fval;
+	memcpy(&fval, &bits, sizeof(fval));
+	return fval;
+}
+
+const char *cave_jsonc_get_tape_string(cave_jsonc_tape_value value, size_t *length) {
+	const char *p = value.tape->strings + TAPE_PAYLOAD(tape_entry(value));
+	if(length)
+		memcpy(length, p, sizeof(size_t));
+	return p + sizeof(size_t);
+}
+
+size_t cave_jsonc_get_tape_length(cave_jsonc_tape_value value) {
+	return TAPE_PAYLOAD(value.tape->entries[TAPE_PAYLOAD(tape_entry(value)) - 1]);
+}
+
+cave_jsonc_tape_value cave_jsonc_get_tape_first_value(cave_jsonc_tape_value array) {
+	return tape_member(array.tape, array.index + 1);
+}
+
+cave_jsonc_tape_value cave_jsonc_next_tape_value(cave_jsonc_tape_value value) {
+	return tape_member(value.tape, tape_skip(value));
+}
+
+cave_jsonc_tape_value cave_jsonc_get_tape_first_kvpair(cave_jsonc_tape_value object) {
+	return tape_member(object.tape, object.index + 1);
+}
+
+cave_jsonc_tape_value cave_jsonc_next_tape_kvpair(cave_jsonc_tape_value pair) {
+	return tape_member(pair.tape, tape_skip(cave_jsonc_get_tape_kvpair_value(pair)));
+}
+
+const char *cave_jsonc_get_tape_key(cave_jsonc_tape_value pair, size_t *length) {
+	return cave_jsonc_get_tape_string(pair, length);
+}
+
+cave_jsonc_tape_value cave_jsonc_get_tape_kvpair_value(cave_jsonc_tape_value pair) {
+	return (cave_jsonc_tape_value) {pair.tape, pair.index + 1};
+}
+
+/**
+ * 对象查找表的槽数，与树形文档的对象索引一样至少是成员个数的两倍
+ */
+static size_t tape_index_slots(size_t members) {
+	size_t capacity = 16;
+	while(capacity < members * 2)
+		capacity *= 2;
+	return capacity;
+}
+
+/**
+ * 返回键所在的槽，不存在时返回空槽
+ */
+static size_t tape_probe(cave_jsonc_tape tape, const uint64_t *table, size_t mask, const char *key, size_t length) {
+	size_t i = hash_key(key, length) & mask;
+	while(table[i]) {
+		size_t klength;
+		const char *k = cave_jsonc_get_tape_string((cave_jsonc_tape_value) {tape, table[i]}, &klength);
+		if(klength == length && !memcmp(k, key, length))
+			break;
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+/**
+ * 成员不少于INDEX_THRESHOLD个的容器各有一张查找表，查找表只依赖条目和字符串，映像中保存同样的内容
+ * index[0]是表的个数，之后每张表占两个字：容器开始条目的下标和表在index中的位置，按下标排序
+ * 数组的表依次是每个元素的下标，对象的表是按键的哈希值线性探测的槽，存放键条目的下标，0表示空槽
+ */
+static void build_tape_index(cave_jsonc_tape tape) {
+	size_t *containers = NULL, count = 0, cap = 0, size = 1;
+	tape->index = NULL;
+	tape->index_size = 0;
+	for(size_t i = 1; i < tape->size;) {
+		int tag = TAPE_TAG(tape->entries[i]);
+		if(tag == TAPE_OBJECT || tag == TAPE_ARRAY) {
+			size_t members = cave_jsonc_get_tape_length((cave_jsonc_tape_value) {tape, i});
+			if(members >= INDEX_THRESHOLD) {
+				if(count == cap) {
+					cap = cap ? cap * 2 : 16;
+					containers = realloc(containers, sizeof(size_t) * cap);
+				}
+				containers[count++] = i;
+				size += 2 + (tag == TAPE_ARRAY ? members : tape_index_slots(members));
+			}
+		}
+		i += tag == TAPE_INTEGER || tag == TAPE_DOUBLE ? 2 : 1;
+	}
+	if(!count)
+		return;
+	uint64_t *index = calloc(size, sizeof(uint64_t));
+	size_t offset = 1 + count * 2;
+	index[0] = count;
+	for(size_t j = 0; j < count; j++) {
+		cave_jsonc_tape_value container = {tape, containers[j]};
+		uint64_t *table = index + offset;
+		index[1 + j * 2] = container.index;
+		index[2 + j * 2] = offset;
+		if(TAPE_TAG(tape_entry(container)) == TAPE_ARRAY) {
+			size_t k = 0;
+			for(cave_jsonc_tape_value value = cave_jsonc_get_tape_first_value(container); value.index;
+					value = cave_jsonc_next_tape_value(value))
+				table[k++] = value.index;
+			offset += k;
+		} else {
+			size_t mask = tape_index_slots(cave_jsonc_get_tape_length(container)) - 1;
+			for(cave_jsonc_tape_value pair = cave_jsonc_get_tape_first_kvpair(container); pair.index;
+					pair = cave_jsonc_next_tape_kvpair(pair)) {
+				size_t length;
+				const char *key = cave_jsonc_get_tape_key(pair, &length);
+				size_t i = tape_probe(tape, table, mask, key, length);
+				if(!table[i])// 有重复的键时保留第一个
+					table[i] = pair.index;
+			}
+			offset += mask + 1;
+		}
+	}
+	free(containers);
+	tape->index = index;
+	tape->index_size = size;
+}
+
+/**
+ * 二分查找容器的查找表，成员较少的容器没有查找表
+ */
+static const uint64_t *tape_table(cave_jsonc_tape_value container) {
+	const uint64_t *index = container.tape->index;
+	if(!index)
+		return NULL;
+	size_t low = 0, high = index[0];
+	while(low < high) {
+		size_t mid = low + (high - low) / 2;
+		if(index[1 + mid * 2] < container.index)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low < index[0] && index[1 + low * 2] == container.index ? index + index[2 + low * 2] : NULL;
+}
+
+cave_jsonc_tape_value cave_jsonc_tape_object_get(cave_jsonc_tape_value object, const char *key, size_t length) {
+	const uint64_t *table = tape_table(object);
+	if(table) {
+		size_t mask = tape_index_slots(cave_jsonc_get_tape_length(object)) - 1;
+		size_t i = table[tape_probe(object.tape, table, mask, key, length)];
+		return (cave_jsonc_tape_value) {object.tape, i ? i + 1 : 0};
+	}
+	for(cave_jsonc_tape_value pair = cave_jsonc_get_tape_first_kvpair(object); pair.index;
+			pair = cave_jsonc_next_tape_kvpair(pair)) {
+		size_t klength;
+		const char *k = cave_jsonc_get_tape_key(pair, &klength);
+		if(klength == length && !memcmp(k, key, length))
+			return cave_jsonc_get_tape_kvpair_value(pair);
+	}
+	return (cave_jsonc_tape_value) {object.tape, 0};
+}
+
+/**
+ * 二进制格式：40字节的文件头之后是根节点，每个值是一个类型字节加内容
+ * 整数和长度使用LEB128变长编码，有符号数先做zigzag变换，double按小端存8字节
+ * 对象和数组先写成员个数，对象的每个成员是长度前缀的键加值
+ * 保存位置时每个值和键之后紧跟行、列和下标
+ */
+#define BINARY_MAGIC "CJB\1"
+#define BINARY_HEADER 40
+
+enum binary_tag {
+	BINARY_NULL,
+	BINARY_FALSE,
+	BINARY_TRUE,
+	BINARY_INTEGER,
+	BINARY_DOUBLE,
+	BINARY_STRING,
+	BINARY_OBJECT,
+	BINARY_ARRAY,
+	/**
+	 * 只有原始文本的数字
+	 */
+	BINARY_RAW_NUMBER,
+	/**
+	 * 与整数或浮点数的标签组合，数值之后附带原始文本
+	 */
+	BINARY_WITH_RAW = 0x10,
+};
+
+/**
+ * 生成二进制时源文件的大小、修改时间和内容的哈希，用来判断缓存是否过期
+ */
+struct binary_stamp {
+	uint64_t size, mtime, mtime_nsec, hash;
+};
+
+static void put_u64(unsigned char *out, uint64_t v) {
+	for(int i = 0; i < 8; i++)
+		out[i] = v >> (8 * i);
+}
+
+static uint64_t get_u64(const unsigned char *in) {
+	uint64_t v = 0;
+	for(int i = 0; i < 8; i++)
+		v |= (uint64_t) in[i] << (8 * i);
+	return v;
+}
+
+static void out_varint(cave_jsonc_writer w, uint64_t v) {
+	while(v >= 0x80) {
+		out_char(w, (char) (v | 0x80));
+		v >>= 7;
+	}
+	out_char(w, (char) v);
+}
+
+static void out_signed(cave_jsonc_writer w, int64_t v) {
+	out_varint(w, ((uint64_t) v << 1) ^ (uint64_t) (v >> 63));
+}
+
+static void out_binary_string(cave_jsonc_writer w, cave_jsonc_string string) {
+	out_varint(w, string->length);
+	out_write(w, string->value, string->length);
+}
+
+static void out_position(cave_jsonc_writer w, cave_jsonc_position p) {
+	out_signed(w, p.row);
+	out_signed(w, p.cols);
+	out_signed(w, p.index);
+}
+
+/**
+ * 遍历树时每层未遍历完的容器，对象记录下一个键值对，数组记录下一个下标
+ */
+struct walk_frame {
+	cave_jsonc_value container;
+	cave_jsonc_kvpair pair;
+	size_t index;
+};
+
+/**
+ * 写入一个值，容器只写入成员个数，成员由serialize_binary_value接着写入
+ */
+static void serialize_binary_head(cave_jsonc_writer w, cave_jsonc_value value, int positions) {
+	unsigned char tag = 0;
+	struct _cave_jsonc_number *num = &value->value.number;
+	switch(value->type) {
+		case CAVE_JSONC_NULL:
+			tag = BINARY_NULL;
+			break;
+		case CAVE_JSONC_BOOLEAN:
+			tag = value->value.boolean ? BINARY_TRUE : BINARY_FALSE;
+			break;
+		case CAVE_JSONC_NUMBER:
+			if(num->flag & CAVE_JSONC_NUM_IVAL)
+				tag = BINARY_INTEGER;
+			else if(num->flag & CAVE_JSONC_NUM_FVAL)
+				tag = BINARY_DOUBLE;
+			else
+				tag = BINARY_RAW_NUMBER;
+			if(tag != BINARY_RAW_NUMBER && (num->flag & CAVE_JSONC_NUM_RAW))
+				tag |= BINARY_WITH_RAW;
+			break;
+		case CAVE_JSONC_STRING:
+			tag = BINARY_STRING;
+			break;
+		case CAVE_JSONC_OBJECT:
+			tag = BINARY_OBJECT;
+			break;
+		case CAVE_JSONC_ARRAY:
+			tag = BINARY_ARRAY;
+			break;
+		case CAVE_JSONC_UNDEFINED:
+			abort(); // IMPOSSIBLE
+	}
+	out_char(w, tag);
+	if(positions)
+		out_position(w, value->position);
+	switch(tag & ~BINARY_WITH_RAW) {
+		case BINARY_INTEGER:
+			out_signed(w, num->ival);
+			break;
+		case BINARY_DOUBLE: {
+			unsigned char bytes[8];
+			uint64_t bits;
+			memcpy(&bits, &num->fval, 8);
+			put_u64(bytes, bits);
+			out_write(w, (const char *) bytes, 8);
+			break;
+		}
+		case BINARY_RAW_NUMBER:
+			out_binary_string(w, num->raw);
+			break;
+		case BINARY_STRING:
+			out_binary_string(w, value->value.string);
+			break;
+		case BINARY_OBJECT:
+			out_varint(w, cave_jsonc_get_object(value)->length);
+			break;
+		case BINARY_ARRAY:
+			out_varint(w, cave_jsonc_get_array(value)->length);
+			break;
+	}
+	if(tag & BINARY_WITH_RAW)
+		out_binary_string(w, num->raw);
+}
+
+/**
+ * 在显式的栈上按先序写入值，嵌套深度不受调用栈大小的限制
+ */
+static void serialize_binary_value(cave_jsonc_writer w, cave_jsonc_value value, int positions) {
+	struct walk_frame *frames = NULL;
+	size_t depth = 0, cap = 0;
+	for(;;) {
+		serialize_binary_head(w, value, positions);
+		if(value->type == CAVE_JSONC_OBJECT || value->type == CAVE_JSONC_ARRAY) {
+			if(depth == cap) {
+				cap = cap ? cap * 2 : 16;
+				frames = realloc(frames, sizeof(struct walk_frame) * cap);
+			}
+			// 延迟解析的容器已经在写入成员个数时解析
+			frames[depth++] = (struct walk_frame) {value,
+				value->type == CAVE_JSONC_OBJECT ? value->value.object->head : NULL, 0};
+		}
+		value = NULL;
+		while(depth && !value) {
+			struct walk_frame *top = &frames[depth - 1];
+			if(top->container->type == CAVE_JSONC_ARRAY) {
+				if(top->index < top->container->value.array->length)
+					value = top->container->value.array->values[top->index++];
+			} else if(top->pair) {
+				out_binary_string(w, top->pair->key);
+				if(positions)
+					out_position(w, top->pair->position);
+				value = top->pair->value;
+				top->pair = top->pair->next;
+			}
+			if(!value)
+				depth--;
+		}
+		if(!value)
+			break;
+	}
+	free(frames);
+}
+
+static void serialize_binary(cave_jsonc_writer w, cave_jsonc_document doc, int options, const struct binary_stamp *stamp) {
+	if(!w->obuf) {
+		w->ocap = OUTPUT_CHUNK;
+		w->obuf = malloc(w->ocap);
+	}
+	w->osize = 0;
+	w->ofailed = 0;
+	unsigned char header[BINARY_HEADER] = BINARY_MAGIC;
+	int positions = options & CAVE_JSONC_BINARY_POSITIONS;
+	header[4] = positions;
+	put_u64(header + 8, stamp ? stamp->size : 0);
+	put_u64(header + 16, stamp ? stamp->mtime : 0);
+	put_u64(header + 24, stamp ? stamp->mtime_nsec : 0);
+	put_u64(header + 32, stamp ? stamp->hash : 0);
+	out_write(w, (const char *) header, BINARY_HEADER);
+	if(doc->root)
+		serialize_binary_value(w, doc->root, positions);
+}
+
+int cave_jsonc_serialize_document_to_binary(cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int options) {
+	struct _cave_jsonc_writer w = {0};
+	w.ffwrite = fwrite;
+	w.fofile = file;
+	serialize_binary(&w, doc, options, NULL);
+	out_flush(&w);
+	free(w.obuf);
+	return w.ofailed ? -1 : 0;
+}
+
+char *cave_jsonc_serialize_document_to_binary_memory(cave_jsonc_document doc, int options, size_t *length) {
+	struct _cave_jsonc_writer w = {0};
+	serialize_binary(&w, doc, options, NULL);
+	if(length)
+		*length = w.osize;
+	return realloc(w.obuf, w.osize ? w.osize : 1);
+}
+
+/**
+ * 读取二进制数据，越界时failed置位，之后的读取都返回0
+ */
+struct binary_reader {
+	const unsigned char *p, *end;
+	int failed;
+};
+
+static uint64_t read_varint(struct binary_reader *r) {
+	uint64_t v = 0;
+	for(int shift = 0; shift < 64; shift += 7) {
+		if(r->p >= r->end)
+			break;
+		unsigned char c = *r->p++;
+		v |= (uint64_t) (c & 0x7f) << shift;
+		if(!(c & 0x80))
+			return v;
+	}
+	r->failed = 1;
+	return 0;
+}
+
+static int64_t read_signed(struct binary_reader *r) {
+	uint64_t v = read_varint(r);
+	return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+static cave_jsonc_position read_position(struct binary_reader *r) {
+	cave_jsonc_position p;
+	p.row = read_signed(r);
+	p.cols = read_signed(r);
+	p.index = read_signed(r);
+	return p;
+}
+
+/**
+ * 读取长度前缀的字符串，返回指向数据中的文本
+ */
+static const char *read_bytes(struct binary_reader *r, size_t *length) {
+	*length = read_varint(r);
+	if(r->failed || *length > (size_t) (r->end - r->p)) {
+		r->failed = 1;
+		return NULL;
+	}
+	const char *s = (const char *) r->p;
+	r->p += *length;
+	return s;
+}
+
+/**
+ * 按文档的模式创建字符串，驻留和借用与解析文本时相同，原始数字总是复制
+ */
+static cave_jsonc_string binary_string(cave_jsonc_document doc, const char *s, size_t length, int key) {
+	if(doc->intern && (key || length <= INTERN_MAX_VALUE))
+		return intern_string(doc->intern, s, length);
+	if(doc->flags & CAVE_JSONC_DOCUMENT_BORROW)
+		return alloc_string(doc, s, length, CAVE_JSONC_STRING_LIFECYCLE_NONE);
+	return alloc_string(doc, s, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+}
+
+/**
+ * 二进制数据中每层未读完的容器
+ */
+struct binary_frame {
+	cave_jsonc_value container;
+	size_t count, filled;
+};
+
+/**
+ * 在显式的栈上读取值，数据损坏时保留已经读出的部分
+ */
+static cave_jsonc_value read_binary_value(cave_jsonc_document doc, struct binary_reader *r, int positions) {
+	struct binary_frame *frames = NULL;
+	size_t depth = 0, cap = 0;
+	cave_jsonc_value root = NULL;
+	while(!r->failed) {
+		struct binary_frame *top = depth ? &frames[depth - 1] : NULL;
+		cave_jsonc_string key = NULL;
+		cave_jsonc_position kp = {-1, -1, -1};
+		if(top && top->container->type == CAVE_JSONC_OBJECT) {
+			size_t length;
+			const char *s = read_bytes(r, &length);
+			if(positions)
+				kp = read_position(r);
+			if(r->failed || r->p >= r->end) {
+				r->failed = 1;
+				break;
+			}
+			key = binary_string(doc, s, length, 1);
+		}
+		if(r->p >= r->end) {
+			r->failed = 1;
+			break;
+		}
+		unsigned char tag = *r->p++;
+		cave_jsonc_position p = positions ? read_position(r) : (cave_jsonc_position) {-1, -1, -1};
+		cave_jsonc_value value = NULL;
+		size_t count = 0;
+		switch(tag & ~BINARY_WITH_RAW) {
+			case BINARY_NULL:
+				value = cave_jsonc_create_null_value(doc);
+				break;
+			case BINARY_FALSE:
+			case BINARY_TRUE:
+				value = cave_jsonc_create_boolean_value(doc, tag == BINARY_TRUE);
+				break;
+			case BINARY_INTEGER:
+				value = cave_jsonc_create_integer_value(doc, read_signed(r));
+				break;
+			case BINARY_DOUBLE:
+				if(r->end - r->p < 8) {
+					r->failed = 1;
+					break;
+				}
+				uint64_t bits = get_u64(r->p);
+				double fval;
+				memcpy(&fval, &bits, 8);
+				r->p += 8;
+				value = cave_jsonc_create_double_value(doc, fval);
+				break;
+			case BINARY_RAW_NUMBER:
+			case BINARY_STRING: {
+				size_t length;
+				const char *s = read_bytes(r, &length);
+				if(r->failed)
+					break;
+				if(tag == BINARY_STRING) {
+					value = alloc_value(doc, CAVE_JSONC_STRING);
+					value->value.string = binary_string(doc, s, length, 0);
+				} else {
+					value = alloc_value(doc, CAVE_JSONC_NUMBER);
+					value->value.number.flag = CAVE_JSONC_NUM_RAW;
+					value->value.number.raw = alloc_string(doc, s, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+				}
+				break;
+			}
+			case BINARY_OBJECT:
+			case BINARY_ARRAY:
+				// 每个成员至少占一个字节，个数不可能超过剩余的字节数
+				count = read_varint(r);
+				if(r->failed || count > (size_t) (r->end - r->p)) {
+					r->failed = 1;
+					break;
+				}
+				if(tag == BINARY_OBJECT) {
+					value = cave_jsonc_create_object_value(doc);
+				} else {
+					value = cave_jsonc_create_array_value(doc, count);
+					for(size_t i = 0; i < count; i++)
+						value->value.array->values[i] = NULL;
+				}
+				break;
+			default:
+				r->failed = 1;
+		}
+		if(value && (tag & BINARY_WITH_RAW)) {
+			size_t length;
+			const char *s = tag == (BINARY_INTEGER | BINARY_WITH_RAW) || tag == (BINARY_DOUBLE | BINARY_WITH_RAW) ?
+				read_bytes(r, &length) : NULL;
+			if(s) {
+				value->value.number.flag |= CAVE_JSONC_NUM_RAW;
+				value->value.number.raw = alloc_string(doc, s, length, CAVE_JSONC_STRING_LIFECYCLE_ALL);
+			} else
+				r->failed = 1;
+		}
+		if(!value) {
+			if(key)
+				release_string(doc, key);
+			break;
+		}
+		cave_jsonc_set_value_position(value, p);
+		// 值创建后立即挂到上一层，出错时已经读出的部分仍然完整
+		if(!top) {
+			root = value;
+		} else if(key) {
+			cave_jsonc_kvpair pair = doc_alloc(doc, sizeof(struct _cave_jsonc_kvpair));
+			pair->object = NULL;
+			pair->key = key;
+			pair->value = value;
+			pair->position = kp;
+			cave_jsonc_move_kvpair_to_object(pair, top->container->value.object);
+			cave_jsonc_insert_last_kvpair(top->container->value.object, pair);
+			top->filled++;
+		} else
+			top->container->value.array->values[top->filled++] = value;
+		if(count) {
+			if(depth == cap) {
+				cap = cap ? cap * 2 : 16;
+				frames = realloc(frames, sizeof(struct binary_frame) * cap);
+			}
+			frames[depth++] = (struct binary_frame) {value, count, 0};
+		}
+		while(depth && frames[depth - 1].filled == frames[depth - 1].count)
+			depth--;
+		if(!depth)
+			break;
+	}
+	// 仍有容器没有读完说明数据被截断，没有读完的数组只保留已经读出的元素
+	if(depth)
+		r->failed = 1;
+	for(size_t i = 0; i < depth; i++)
+		if(frames[i].container->type == CAVE_JSONC_ARRAY)
+			frames[i].container->value.array->length = frames[i].filled;
+	free(frames);
+	return root;
+}
+
+/**
+ * 检查文件头，返回值为0表示不是这个格式
+ */
+static int read_binary_header(const unsigned char *data, size_t length, int *positions, struct binary_stamp *stamp) {
+	if(length < BINARY_HEADER || memcmp(data, BINARY_MAGIC, 4) || data[4] > 1)
+		return 0;
+	*positions = data[4];
+	stamp->size = get_u64(data + 8);
+	stamp->mtime = get_u64(data + 16);
+	stamp->mtime_nsec = get_u64(data + 24);
+	stamp->hash = get_u64(data + 32);
+	return 1;
+}
+
+cave_jsonc_document cave_jsonc_parse_binary(const char *data, size_t length, int flags) {
+	cave_jsonc_document doc = cave_jsonc_create_document_with_flags(flags);
+	if(flags & CAVE_JSONC_DOCUMENT_INTERN)
+		doc->intern = cave_jsonc_create_intern();
+	int positions;
+	struct binary_stamp stamp;
+	if(!read_binary_header((const unsigned char *) data, length, &positions, &stamp)) {
+		cave_jsonc_report_error(doc, "不是有效的二进制文档", (cave_jsonc_position) {-1, -1, -1}, 1);
+		return doc;
+	}
+	struct binary_reader r = {(const unsigned char *) data + BINARY_HEADER, (const unsigned char *) data + length, 0};
+	if(r.p < r.end)
+		cave_jsonc_set_document_root(doc, read_binary_value(doc, &r, positions));
+	if(r.failed)
+		cave_jsonc_report_error(doc, "二进制文档不完整或已损坏", (cave_jsonc_position) {-1, -1, -1}, 1);
+	else if(r.p < r.end)
+		cave_jsonc_report_error(doc, "二进制文档之后仍有内容", (cave_jsonc_position) {-1, -1, -1}, 1);
+	return doc;
+}
+
+static size_t fd_write(const void *data, size_t length, void *file) {
+	size_t done = 0;
+	while(done < length) {
+		ssize_t n = write(*(int *) file, (const char *) data + done, length - done);
+		if(n <= 0)
+			break;
+		done += n;
+	}
+	return done;
+}
+
+/**
+ * 先写到同一目录下的临时文件，写完再改名，其他进程不会读到写了一半的文件
+ * 临时文件名由mkstemp生成，同时写同一个文件的线程和进程各自使用不同的临时文件
+ */
+static int open_temp(const char *path, char **temp) {
+	size_t length = strlen(path) + 8;
+	*temp = malloc(length);
+	snprintf(*temp, length, "%s.XXXXXX", path);
+	int fd = mkstemp(*temp);
+	if(fd < 0)
+		free(*temp);
+	else
+		fchmod(fd, 0644);// mkstemp创建的文件只有所有者可读，其他进程也要能映射
+	return fd;
+}
+
+static int replace_with_temp(int fd, char *temp, const char *path, int failed) {
+	if(close(fd) < 0 || failed || rename(temp, path) < 0) {
+		unlink(temp);
+		failed = 1;
+	}
+	free(temp);
+	return failed ? -1 : 0;
+}
+
+static void write_cache(cave_jsonc_document doc, const char *cache, int options, const struct binary_stamp *stamp) {
+	char *temp;
+	int fd = open_temp(cache, &temp);
+	if(fd < 0)
+		return;
+	struct _cave_jsonc_writer w = {0};
+	w.ffwrite = fd_write;
+	w.fofile = &fd;
+	serialize_binary(&w, doc, options, stamp);
+	out_flush(&w);
+	free(w.obuf);
+	// 延迟解析的容器在序列化时才解析，其中的错误这时才出现，有错误的文档不写缓存
+	replace_with_temp(fd, temp, cache, w.ofailed || doc->error_head);
+}
+
+cave_jsonc_document cave_jsonc_load_file_cached(const char *path, const char *cache, int flags, int options) {
+	struct stat st;
+	if(stat(path, &st) < 0)
+		return cave_jsonc_parse_file(path, flags);
+	struct binary_stamp stamp = {st.st_size, st.st_mtim.tv_sec, st.st_mtim.tv_nsec, 0};
+	void *source = NULL, *mapping;
+	size_t length, cache_length;
+	cave_jsonc_document doc;
+	if(options & CAVE_JSONC_BINARY_VERIFY_HASH) {
+		if((doc = map_file(path, flags, &source, &length)))
+			return doc;
+		stamp.hash = hash_key(source, length);
+	}
+	if(!(doc = map_file(cache, flags, &mapping, &cache_length))) {
+		int positions;
+		struct binary_stamp cached;
+		if(read_binary_header(mapping, cache_length, &positions, &cached) && cached.size == stamp.size &&
+				(options & CAVE_JSONC_BINARY_VERIFY_HASH ? cached.hash == stamp.hash :
+				 cached.mtime == stamp.mtime && cached.mtime_nsec == stamp.mtime_nsec)) {
+			doc = release_mapping(cave_jsonc_parse_binary(mapping, cache_length, flags), mapping, cache_length);
+			if(!cave_jsonc_has_fatal_error(doc)) {
+				if(source)
+					munmap(source, length);
+				return doc;
+			}
+			cave_jsonc_release_all_nodes_in_document(doc);
+		} else if(mapping)
+			munmap(mapping, cache_length);
+	}
+	if(doc)
+		cave_jsonc_release_document(doc);
+	// 缓存不存在或已经过期，解析文本并重写缓存
+	if(!source && (doc = map_file(path, flags, &source, &length)))
+		return doc;
+	stamp.hash = hash_key(source, length);
+	doc = cave_jsonc_parse_buffer(source, length, flags);
+	if(!doc->error_head)
+		write_cache(doc, cache, options, &stamp);
+	return release_mapping(doc, source, length);
+}
+
+/**
+ * 磁带映像：40字节的文件头之后依次是条目数组、查找表和字符串区，全部使用本机字节序
+ * 文件头依次是魔数、字节序标记、size_t的大小、保留的4字节、条目个数、查找表的字数和字符串区的字节数
+ * 条目和查找表中只有下标和偏移，没有指针，映射到任何地址都可以直接查询
+ */
+#define TAPE_IMAGE_MAGIC "CJT\2"
+#define TAPE_IMAGE_HEADER 40
+#define TAPE_IMAGE_ORDER UINT32_C(0x01020304)
+
+/**
+ * 把文档中的值依次写入磁带，延迟解析的容器先解析
+ */
+static void tape_put_value(cave_jsonc_tape tape, cave_jsonc_value value) {
+	struct walk_frame *frames = NULL;
+	size_t depth = 0, cap = 0;
+	for(;;) {
+		switch(value->type) {
+			case CAVE_JSONC_NULL:
+				tape_null(tape, value->position);
+				break;
+			case CAVE_JSONC_BOOLEAN:
+				tape_boolean(tape, value->value.boolean, value->position);
+				break;
+			case CAVE_JSONC_NUMBER: {
+				cave_jsonc_sax_number number;
+				number.raw = NULL;
+				number.length = 0;
+				number.fval = cave_jsonc_get_double(value);
+				number.integer = (value->value.number.flag & CAVE_JSONC_NUM_IVAL) != 0;
+				number.ival = number.integer ? value->value.number.ival : 0;
+				tape_number(tape, &number, value->position);
+				break;
+			}
+			case CAVE_JSONC_STRING:
+				tape_string_value(tape, value->value.string->value, value->value.string->length, value->position);
+				break;
+			case CAVE_JSONC_OBJECT:
+			case CAVE_JSONC_ARRAY:
+				if(depth == cap) {
+					cap = cap ? cap * 2 : 16;
+					frames = realloc(frames, sizeof(struct walk_frame) * cap);
+				}
+				if(value->type == CAVE_JSONC_OBJECT) {
+					tape_start(tape, TAPE_OBJECT);
+					frames[depth++] = (struct walk_frame) {value, cave_jsonc_get_object(value)->head, 0};
+				} else {
+					tape_start(tape, TAPE_ARRAY);
+					cave_jsonc_get_array(value);// 延迟解析的数组先解析
+					frames[depth++] = (struct walk_frame) {value, NULL, 0};
+				}
+				break;
+			case CAVE_JSONC_UNDEFINED:
+				abort(); // IMPOSSIBLE
+		}
+		// 找到下一个值，遍历完的容器依次结束
+		value = NULL;
+		while(depth && !value) {
+			struct walk_frame *top = &frames[depth - 1];
+			if(top->container->type == CAVE_JSONC_ARRAY) {
+				if(top->index < top->container->value.array->length)
+					value = top->container->value.array->values[top->index++];
+				else
+					tape_end(tape, TAPE_ARRAY_END);
+			} else if(top->pair) {
+				tape_key(tape, top->pair->key->value, top->pair->key->length, top->pair->position);
+				value = top->pair->value;
+				top->pair = top->pair->next;
+			} else
+				tape_end(tape, TAPE_OBJECT_END);
+			if(!value)
+				depth--;
+		}
+		if(!value)
+			break;
+	}
+	free(frames);
+}
+
+cave_jsonc_tape cave_jsonc_document_to_tape(cave_jsonc_document doc) {
+	cave_jsonc_tape tape = alloc_tape();
+	if(doc->root)
+		tape_put_value(tape, doc->root);
+	return finish_tape(tape, cave_jsonc_create_document());
+}
+
+static void tape_image(cave_jsonc_writer w, cave_jsonc_tape tape) {
+	if(!w->obuf) {
+		w->ocap = OUTPUT_CHUNK;
+		w->obuf = malloc(w->ocap);
+	}
+	w->osize = 0;
+	w->ofailed = 0;
+	unsigned char header[TAPE_IMAGE_HEADER] = TAPE_IMAGE_MAGIC;
+	uint32_t order = TAPE_IMAGE_ORDER, size_width = sizeof(size_t);
+	uint64_t count = tape->size, index = tape->index_size, strings = tape->strings_size;
+	memcpy(header + 4, &order, 4);
+	memcpy(header + 8, &size_width, 4);
+	memcpy(header + 16, &count, 8);
+	memcpy(header + 24, &index, 8);
+	memcpy(header + 32, &strings, 8);
+	out_write(w, (const char *) header, TAPE_IMAGE_HEADER);
+	out_write(w, (const char *) tape->entries, sizeof(uint64_t) * tape->size);
+	if(tape->index_size)
+		out_write(w, (const char *) tape->index, sizeof(uint64_t) * tape->index_size);
+	out_write(w, tape->strings, tape->strings_size);
+	out_flush(w);
+}
+
+int cave_jsonc_write_tape_image(cave_jsonc_tape tape, size_t (*fwrite)(const void *data, size_t length, void *file), void *file) {
+	struct _cave_jsonc_writer w = {0};
+	w.ffwrite = fwrite;
+	w.fofile = file;
+	tape_image(&w, tape);
+	free(w.obuf);
+	return w.ofailed ? -1 : 0;
+}
+
+int cave_jsonc_save_tape_image(cave_jsonc_tape tape, const char *path) {
+	char *temp;
+	int fd = open_temp(path, &temp);
+	if(fd < 0)
+		return -1;
+	struct _cave_jsonc_writer w = {0};
+	w.ffwrite = fd_write;
+	w.fofile = &fd;
+	tape_image(&w, tape);
+	free(w.obuf);
+	return replace_with_temp(fd, temp, path, w.ofailed);
+}
+
+/**
+ * 检查映像时每层未结束的容器
+ */
+struct tape_check_frame {
+	uint64_t end, members;
+	int object, key;
+};
+
+/**
+ * 检查字符串的偏移和长度都在字符串区内，并且以\0结尾
+ */
+static int check_tape_string(uint64_t offset, const char *strings, uint64_t size) {
+	size_t length;
+	if(offset > size || size - offset < sizeof(size_t) + 1)
+		return 0;
+	memcpy(&length, strings + offset, sizeof(size_t));
+	return length <= size - offset - sizeof(size_t) - 1 && !strings[offset + sizeof(size_t) + length];
+}
+
+/**
+ * 逐个检查条目，映像中恰好有一个根节点，容器的开始和结束条目配对，成员个数与结束条目一致
+ * 对象的成员是字符串键和值交替出现，访问函数之后不再检查下标和偏移
+ */
+static int check_tape_entries(const uint64_t *entries, uint64_t count, const char *strings, uint64_t strings_size) {
+	struct tape_check_frame *frames = NULL;
+	size_t depth = 0, cap = 0;
+	uint64_t i = 1;
+	int ok = 1;
+	while(ok && i < count) {
+		struct tape_check_frame *top = depth ? &frames[depth - 1] : NULL;
+		int tag = TAPE_TAG(entries[i]);
+		uint64_t payload = TAPE_PAYLOAD(entries[i]);
+		if(!top && i > 1) {
+			ok = 0;// 根节点之后还有内容
+			break;
+		}
+		if(top && i == top->end) {
+			ok = tag == (top->object ? TAPE_OBJECT_END : TAPE_ARRAY_END) && payload == top->members && !top->key;
+			depth--;
+			i++;
+			continue;
+		}
+		if(top && top->object) {
+			// 键计入对象的成员个数，下一个条目是值
+			if(top->key) {
+				top->key = 0;
+			} else {
+				ok = tag == TAPE_STRING && check_tape_string(payload, strings, strings_size);
+				top->members++;
+				top->key = 1;
+				i++;
+				continue;
+			}
+		} else if(top)
+			top->members++;
+		switch(tag) {
+			case TAPE_NULL:
+			case TAPE_TRUE:
+			case TAPE_FALSE:
+				i++;
+				break;
+			case TAPE_INTEGER:
+			case TAPE_DOUBLE:
+				i += 2;
+				ok = i <= (top ? top->end : count);
+				break;
+			case TAPE_STRING:
+				ok = check_tape_string(payload, strings, strings_size);
+				i++;
+				break;
+			case TAPE_OBJECT:
+			case TAPE_ARRAY:
+				// 附加值是结束条目之后的下标，必须在上一层容器之内
+				if(payload < i + 2 || payload > (top ? top->end : count)) {
+					ok = 0;
+					break;
+				}
+				if(depth == cap) {
+					cap = cap ? cap * 2 : 16;
+					frames = realloc(frames, sizeof(struct tape_check_frame) * cap);
+				}
+				frames[depth++] = (struct tape_check_frame) {payload - 1, 0, tag == TAPE_OBJECT, 0};
+				i++;
+				break;
+			default:
+				ok = 0;
+		}
+	}
+	free(frames);
+	return ok && !depth && i == count;
+}
+
+/**
+ * 检查文件头、各部分的大小和每个条目，再按条目重建查找表，必须与映像中的完全相同
+ */
+static int check_tape_image(const unsigned char *data, size_t length, uint64_t *count, uint64_t *index, uint64_t *strings) {
+	uint32_t order, size_width;
+	if(length < TAPE_IMAGE_HEADER || memcmp(data, TAPE_IMAGE_MAGIC, 4))
+		return 0;
+	memcpy(&order, data + 4, 4);
+	memcpy(&size_width, data + 8, 4);
+	memcpy(count, data + 16, 8);
+	memcpy(index, data + 24, 8);
+	memcpy(strings, data + 32, 8);
+	if(order != TAPE_IMAGE_ORDER || size_width != sizeof(size_t) || !*count)
+		return 0;
+	size_t words = (length - TAPE_IMAGE_HEADER) / sizeof(uint64_t);
+	if(*count > words || *index > words - *count ||
+			*strings != length - TAPE_IMAGE_HEADER - (*count + *index) * sizeof(uint64_t))
+		return 0;
+	uint64_t root;
+	memcpy(&root, data + TAPE_IMAGE_HEADER, 8);
+	const uint64_t *entries = (const uint64_t *) (data + TAPE_IMAGE_HEADER);
+	struct _cave_jsonc_tape check = {0};
+	check.entries = (uint64_t *) entries;
+	check.size = *count;
+	check.strings = (char *) (entries + *count + *index);
+	check.strings_size = *strings;
+	if(root != TAPE_ENTRY(TAPE_ROOT, *count) || !check_tape_entries(entries, *count, check.strings, *strings))
+		return 0;
+	build_tape_index(&check);
+	int same = check.index_size == *index &&
+		(!*index || !memcmp(check.index, entries + *count, sizeof(uint64_t) * *index));
+	free(check.index);
+	return same;
+}
+
+cave_jsonc_tape cave_jsonc_map_tape_image(const char *path) {
+	void *mapping;
+	size_t length;
+	uint64_t count, index, strings;
+	cave_jsonc_document doc = map_file(path, 0, &mapping, &length);
+	if(!doc && !check_tape_image(mapping, length, &count, &index, &strings)) {
+		if(mapping)
+			munmap(mapping, length);
+		doc = cave_jsonc_create_document();
+		cave_jsonc_report_error(doc, "不是有效的磁带映像", (cave_jsonc_position) {-1, -1, -1}, 1);
+	}
+	if(doc)
+		return finish_tape(alloc_tape(), doc);
+	cave_jsonc_tape tape = calloc(1, sizeof(struct _cave_jsonc_tape));
+	madvise(mapping, length, MADV_RANDOM);
+	tape->mapping = mapping;
+	tape->mapping_length = length;
+	tape->entries = (uint64_t *) ((char *) mapping + TAPE_IMAGE_HEADER);
+	tape->size = tape->cap = count;
+	tape->index = index ? tape->entries + count : NULL;
+	tape->index_size = index;
+	tape->strings = (char *) (tape->entries + count + index);
+	tape->strings_size = tape->strings_cap = strings;
+	tape->doc = cave_jsonc_create_document();
+	return tape;
+}
+
+cave_jsonc_tape_value cave_jsonc_tape_array_get(cave_jsonc_tape_value array, size_t index) {
+	const uint64_t *table = tape_table(array);
+	if(table)
+		return (cave_jsonc_tape_value) {array.tape, index < cave_jsonc_get_tape_length(array) ? table[index] : 0};
+	cave_jsonc_tape_value value = cave_jsonc_get_tape_first_value(array);
+	while(index-- && value.index)
+		value = cave_jsonc_next_tape_value(value);
+	return value;
 }
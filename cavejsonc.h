@@ -33,6 +33,7 @@ typedef struct cave_jsonc_position {
 /**
  * 用于表示一个utf-8字符串
  * value的末尾有\0但不计入length
+ * 借用源缓冲区的字符串（见CAVE_JSONC_DOCUMENT_BORROW）末尾没有\0，以length为准
  */
 typedef struct _cave_jsonc_string {
 	/**
@@ -50,7 +51,8 @@ typedef struct _cave_jsonc_string {
 } *cave_jsonc_string;
 
 /**
- * @deprecated 内部使用，用于表示数字对应的形式是否被计算
+ * @deprecated 内部使用，表示数字中哪些形式有效
+ * IVAL和FVAL最多只有一个，数值存放在共用的ival/fval中
  */
 typedef enum cave_jsonc_number_flag {
 	CAVE_JSONC_NUM_FVAL = 1,
@@ -59,12 +61,15 @@ typedef enum cave_jsonc_number_flag {
 } cave_jsonc_number_flag;
 
 /**
- * @deprecated 内部使用，用于表示数字
+ * @deprecated 内部使用，用于表示数字，直接存放在cave_jsonc_value中
+ * 解析时就确定是整数还是浮点数，原始文本只在需要时保留
  */
 typedef struct _cave_jsonc_number {
 	struct _cave_jsonc_string *raw;
-	double fval;
-	long long ival;
+	union {
+		double fval;
+		long long ival;
+	};
 	char flag;
 } *cave_jsonc_number;
 
@@ -121,14 +126,56 @@ typedef struct _cave_jsonc_object {
 	 * 所属值
 	 */
 	struct _cave_jsonc_value *value;
+	/**
+	 * 链表中键值对的个数
+	 */
+	size_t length;
+	/**
+	 * 按键查找用的哈希索引，键值对较多时在第一次查找时建立，插入和取出键值对时维护
+	 */
+	struct _cave_jsonc_object_index *index;
 } *cave_jsonc_object;
 
+/**
+ * 文档的工作模式，可以按位组合
+ */
+typedef enum cave_jsonc_document_flag {
+	/**
+	 * 值、键值对和字符串都从文档持有的大块内存中分配
+	 * 释放文档时整块归还，不再逐个free
+	 * 这种模式下的值不能转移到其他文档，数组的values也不能被realloc
+	 */
+	CAVE_JSONC_DOCUMENT_ARENA = 1,
+	/**
+	 * 从内存或文件解析时，不含转义的键和字符串直接指向源缓冲区，生命周期为NONE
+	 * 调用者提供的缓冲区必须比文档活得久，cave_jsonc_parse_file的映射由文档持有
+	 */
+	CAVE_JSONC_DOCUMENT_BORROW = 2,
+	/**
+	 * 解析时保留数字的原始文本，借用模式下直接指向源缓冲区
+	 * 默认只保存解码后的数值
+	 */
+	CAVE_JSONC_DOCUMENT_RAW_NUMBER = 4,
+	/**
+	 * 从内存或文件解析时只解析根容器的直属成员，嵌套的容器只匹配括号后跳过
+	 * 跳过的容器在第一次通过cave_jsonc_get_object或cave_jsonc_get_array访问时才解析，其中的错误在这时报告
+	 * 源缓冲区的要求与CAVE_JSONC_DOCUMENT_BORROW相同，访问会修改文档，不能在多个线程中同时读取
+	 */
+	CAVE_JSONC_DOCUMENT_LAZY = 8,
+	/**
+	 * 解析时键和不长的字符串值放进驻留表，相同内容的字符串共用一个只读的cave_jsonc_string
+	 * 驻留表默认每个文档一个，也可以通过cave_jsonc_parser_set_intern让多个文档共用
+	 */
+	CAVE_JSONC_DOCUMENT_INTERN = 16,
+} cave_jsonc_document_flag;
+
 /**
  * 一个json文档，它负责内存分配和回收和错误记录
  */
 typedef struct _cave_jsonc_document {
 	/**
 	 * 根节点和分配的所有值的链表
+	 * arena模式下值不挂在链表上
 	 */
 	struct _cave_jsonc_value *root, *all_allocated;
 	/**
@@ -139,6 +186,33 @@ typedef struct _cave_jsonc_document {
 	 * 记录是否有致命错误
 	 */
 	int fatal;
+	/**
+	 * cave_jsonc_document_flag的组合
+	 */
+	int flags;
+	/**
+	 * arena模式下的内存块链表，头部是当前正在使用的块
+	 */
+	struct _cave_jsonc_arena *arena;
+	/**
+	 * 借用模式下文档持有的文件映射，释放文档时解除映射
+	 */
+	void *mapping;
+	size_t mapping_length;
+	/**
+	 * 延迟解析模式下的源文本，位置中的index减1是字符在其中的偏移
+	 */
+	const char *source;
+	size_t source_length;
+	/**
+	 * 驻留模式下使用的驻留表，文档持有一个引用
+	 */
+	struct _cave_jsonc_intern *intern;
+	/**
+	 * 解析期间记录分配和错误的统计，解析结束后为NULL
+	 * 不论是否定义CAVE_JSONC_STATS都保留这个字段，结构的布局与编译选项无关
+	 */
+	struct cave_jsonc_stats *stats;
 } *cave_jsonc_document;
 
 typedef int cave_jsonc_boolean;
@@ -175,8 +249,18 @@ typedef struct _cave_jsonc_value {
 		cave_jsonc_object object;
 		cave_jsonc_array array;
 		cave_jsonc_string string;
-		cave_jsonc_number number;
+		struct _cave_jsonc_number number;
 		cave_jsonc_boolean boolean;
+		/**
+		 * 延迟解析模式下还没有解析的容器，container为NULL，end是右括号在源文本中的偏移
+		 * max_depth是解析这个容器时还允许的嵌套层数，0表示不限制
+		 * 这时的object和array也是NULL，应当通过cave_jsonc_get_object和cave_jsonc_get_array访问
+		 */
+		struct {
+			void *container;
+			size_t end;
+			size_t max_depth;
+		} lazy;
 	} value;
 } *cave_jsonc_value;
 
@@ -202,7 +286,90 @@ typedef struct _cave_jsonc_error {
 	struct _cave_jsonc_error *next;
 } *cave_jsonc_error;
 
+/**
+ * 事件解析时收到的数字
+ * integer非0时数字没有小数部分和指数且没有溢出，值在ival中，fval是对应的double
+ * raw是数字的原始文本，以\0结尾，只在回调期间有效
+ */
+typedef struct cave_jsonc_sax_number {
+	const char *raw;
+	size_t length;
+	int integer;
+	long long ival;
+	double fval;
+} cave_jsonc_sax_number;
+
+/**
+ * 事件解析的回调，不关心的事件可以为NULL
+ * 回调返回非0时立即停止解析
+ * 传入的键和字符串只在回调期间有效，从内存解析时没有转义的字符串直接指向源缓冲区，不以\0结尾
+ */
+typedef struct cave_jsonc_sax_handler {
+	int (*start_object)(void *user, cave_jsonc_position position);
+	int (*end_object)(void *user);
+	int (*start_array)(void *user, cave_jsonc_position position);
+	int (*end_array)(void *user);
+	int (*key)(void *user, const char *key, size_t length, cave_jsonc_position position);
+	int (*string)(void *user, const char *value, size_t length, cave_jsonc_position position);
+	int (*number)(void *user, const cave_jsonc_sax_number *number, cave_jsonc_position position);
+	int (*boolean)(void *user, int value, cave_jsonc_position position);
+	int (*null)(void *user, cave_jsonc_position position);
+} cave_jsonc_sax_handler;
+
+/**
+ * 字符串驻留表，按引用计数释放，不能在多个线程中同时使用
+ * 驻留的字符串在表释放前一直有效
+ * 把值移到没有驻留表的文档时，目标文档持有原来的表的引用；目标文档已有其他驻留表时，复制值直接引用的驻留字符串
+ */
+typedef struct _cave_jsonc_intern *cave_jsonc_intern;
+
+/**
+ * 解析器，保存一次解析的全部状态和可以重复使用的暂存区
+ * 不同的解析器互不影响，可以交替使用，同一个解析器同时只能进行一次解析
+ */
+typedef struct _cave_jsonc_parser *cave_jsonc_parser;
+
+/**
+ * 序列化器，保存一次序列化的全部状态和可以重复使用的输出缓冲区
+ */
+typedef struct _cave_jsonc_writer *cave_jsonc_writer;
+
+/**
+ * 只读的紧凑文档，所有值依次存放在一个64位条目的数组中，字符串集中存放
+ * 每个标量只占一到两个条目，跳过一个容器只需要一次查表
+ */
+typedef struct _cave_jsonc_tape *cave_jsonc_tape;
+
+/**
+ * 磁带中的一个值或键值对，index为0表示不存在
+ */
+typedef struct cave_jsonc_tape_value {
+	struct _cave_jsonc_tape *tape;
+	size_t index;
+} cave_jsonc_tape_value;
+
+/**
+ * 按行分隔的一批记录（NDJSON/JSON Lines）的解析结果，每条记录一个文档
+ */
+typedef struct _cave_jsonc_batch *cave_jsonc_batch;
+
+/**
+ * 编译好的JSON Pointer，每段的键已经去掉转义并算好哈希，可以对不同的文档反复使用
+ */
+typedef struct _cave_jsonc_path *cave_jsonc_path;
+
+/**
+ * 多条路径合并成的前缀树，一次遍历回答所有路径
+ */
+typedef struct _cave_jsonc_path_set *cave_jsonc_path_set;
+
+/**
+ * 推送式解析器，输入可以分成任意多块送入，不会阻塞
+ */
+typedef struct _cave_jsonc_push_parser *cave_jsonc_push_parser;
+
 cave_jsonc_document cave_jsonc_create_document(void);
+cave_jsonc_document cave_jsonc_create_document_with_flags(int flags);
 void cave_jsonc_release_all_nodes_in_document(cave_jsonc_document doc);
 void cave_jsonc_transform_node_document(cave_jsonc_value value, cave_jsonc_document target);
 void cave_jsonc_release_document(cave_jsonc_document doc);
@@ -240,13 +407,264 @@ cave_jsonc_kvpair cave_jsonc_insert_last_kvpair(cave_jsonc_object object, cave_j
 cave_jsonc_kvpair cave_jsonc_next_kvpair(cave_jsonc_kvpair pair);
 cave_jsonc_kvpair cave_jsonc_previous_kvpair(cave_jsonc_kvpair pair);
 cave_jsonc_kvpair cave_jsonc_take_kvpair_from_object(cave_jsonc_kvpair pair);
+cave_jsonc_kvpair cave_jsonc_object_get_kvpair(cave_jsonc_object object, const char *key, size_t length);
+cave_jsonc_value cave_jsonc_object_get(cave_jsonc_object object, const char *key, size_t length);
+cave_jsonc_value cave_jsonc_object_remove(cave_jsonc_object object, const char *key, size_t length);
 void cave_json_release_kvpair(cave_jsonc_kvpair pair);
 
 cave_jsonc_array cave_jsonc_get_array(cave_jsonc_value value);
 cave_jsonc_object cave_jsonc_get_object(cave_jsonc_value value);
+/**
+ * 路径的选项，可以按位组合
+ */
+typedef enum cave_jsonc_path_option {
+	/**
+	 * 扩展：整段为*时匹配对象或数组的所有成员，~2表示字面的*
+	 */
+	CAVE_JSONC_PATH_WILDCARD = 1,
+} cave_jsonc_path_option;
+/**
+ * 编译RFC 6901的JSON Pointer，格式错误时返回NULL
+ * cave_jsonc_compile_path严格按照RFC 6901，*是普通字符，~之后只能是0或1
+ */
+cave_jsonc_path cave_jsonc_compile_path(const char *pointer, size_t length);
+cave_jsonc_path cave_jsonc_compile_path_with_options(const char *pointer, size_t length, int options);
+void cave_jsonc_release_path(cave_jsonc_path path);
+/**
+ * 返回从value开始按路径找到的第一个值，不存在时返回NULL
+ */
+cave_jsonc_value cave_jsonc_path_get(cave_jsonc_path path, cave_jsonc_value value);
+/**
+ * 按文档顺序把匹配的值放进results，最多capacity个，返回匹配的总数
+ */
+size_t cave_jsonc_path_query(cave_jsonc_path path, cave_jsonc_value value, cave_jsonc_value *results, size_t capacity);
+/**
+ * 编译count条以\0结尾的JSON Pointer，共同的前缀只匹配一次，任何一条格式错误时返回NULL
+ */
+cave_jsonc_path_set cave_jsonc_compile_path_set(const char *const *pointers, size_t count);
+cave_jsonc_path_set cave_jsonc_compile_path_set_with_options(const char *const *pointers, size_t count, int options);
+void cave_jsonc_release_path_set(cave_jsonc_path_set set);
+/**
+ * 一次遍历找到每条路径的第一个值，results[i]是第i条路径的结果，不存在时为NULL
+ */
+void cave_jsonc_path_set_get(cave_jsonc_path_set set, cave_jsonc_value value, cave_jsonc_value *results);
+/**
+ * 一次遍历找到所有匹配，每个匹配调用一次found，index是路径的序号，found返回非0时停止
+ */
+void cave_jsonc_path_set_query(cave_jsonc_path_set set, cave_jsonc_value value,
+		int (*found)(void *user, size_t index, cave_jsonc_value value), void *user);
 
 cave_jsonc_document cave_jsonc_parse_document(int (*fgetc)(void *file), void *file);
+cave_jsonc_document cave_jsonc_parse_document_with_flags(int (*fgetc)(void *file), void *file, int flags);
+cave_jsonc_document cave_jsonc_parse_buffer(const char *data, size_t length, int flags);
+cave_jsonc_document cave_jsonc_parse_file(const char *path, int flags);
+/**
+ * 使用给定的解析器解析，行为和对应的不带解析器的接口相同
+ */
+cave_jsonc_parser cave_jsonc_create_parser(void);
+void cave_jsonc_release_parser(cave_jsonc_parser parser);
+/**
+ * 设置容器的最大嵌套层数，超过时报告致命错误，0表示不限制（默认）
+ * 解析使用显式的栈，不会因为嵌套过深耗尽调用栈
+ */
+void cave_jsonc_parser_set_max_depth(cave_jsonc_parser parser, size_t depth);
+cave_jsonc_intern cave_jsonc_create_intern(void);
+/**
+ * 释放调用者持有的引用，所有使用它的文档和解析器释放后驻留表才真正释放
+ */
+void cave_jsonc_release_intern(cave_jsonc_intern intern);
+/**
+ * 之后以CAVE_JSONC_DOCUMENT_INTERN解析的文档都使用这个驻留表，NULL表示每个文档一个
+ */
+void cave_jsonc_parser_set_intern(cave_jsonc_parser parser, cave_jsonc_intern intern);
+/**
+ * 解析或序列化的统计，计数在多次解析之间累加，由调用者清零
+ * 解析时bytes是读取的字节数，序列化时是输出的字节数，其余字段含义相同
+ * 只有定义了CAVE_JSONC_STATS编译时才会记录，否则设置统计的函数什么也不做
+ */
+typedef struct cave_jsonc_stats {
+	size_t bytes;
+	/**
+	 * 按cave_jsonc_type分类的值的个数
+	 */
+	size_t nodes[CAVE_JSONC_ARRAY + 1];
+	/**
+	 * 字符串中原样复制的字节和经过转义处理的字节，借用源缓冲区的字符串不计入
+	 */
+	size_t string_bytes_copied, string_bytes_escaped;
+	size_t allocations, allocated_bytes;
+	size_t max_depth;
+	/**
+	 * 各阶段的耗时，单位纳秒，structure_ns是总耗时减去其他阶段
+	 */
+	unsigned long long skip_ns, string_ns, number_ns, structure_ns;
+	size_t errors, warnings;
+} cave_jsonc_stats;
+/**
+ * 之后用这个解析器构建文档时把统计累加到stats，NULL表示不统计
+ * 不带解析器的接口和多线程、批量解析内部创建的解析器不统计
+ */
+void cave_jsonc_parser_set_stats(cave_jsonc_parser parser, cave_jsonc_stats *stats);
+cave_jsonc_document cave_jsonc_parser_parse_document(cave_jsonc_parser parser,
+		int (*fgetc)(void *file), void *file, int flags);
+cave_jsonc_document cave_jsonc_parser_parse_buffer(cave_jsonc_parser parser, const char *data, size_t length, int flags);
+cave_jsonc_document cave_jsonc_parser_parse_file(cave_jsonc_parser parser, const char *path, int flags);
+/**
+ * 多线程解析根是数组或对象的大文档，根容器的成员分给threads个线程解析，threads<=0时使用所有CPU
+ * 结果和错误信息与cave_jsonc_parse_buffer/cave_jsonc_parse_file相同，文档较小或有错误时退化为顺序解析
+ */
+cave_jsonc_document cave_jsonc_parse_buffer_parallel(const char *data, size_t length, int flags, int threads);
+cave_jsonc_document cave_jsonc_parse_file_parallel(const char *path, int flags, int threads);
+/**
+ * 解析一批按换行分隔的记录，只有空白的行被跳过，记录不能跨行
+ * 记录分给threads个线程解析，threads<=0时使用所有CPU，结果与逐条调用cave_jsonc_parse_buffer相同
+ * 记录中的位置从记录开头算起，cave_jsonc_get_batch_line给出记录所在的行号
+ */
+cave_jsonc_batch cave_jsonc_parse_batch_buffer(const char *data, size_t length, int flags, int threads);
+cave_jsonc_batch cave_jsonc_parse_batch_file(const char *path, int flags, int threads);
+/**
+ * 按事件解析一批记录，返回的文档只保存错误
+ * 不同记录的回调可能同时在不同线程中执行，同一条记录的回调在同一个线程中依次执行
+ * record不为NULL时在解析第index条记录前调用，返回值作为这条记录的回调的user
+ */
+cave_jsonc_batch cave_jsonc_parse_batch_events(const char *data, size_t length, const cave_jsonc_sax_handler *handler,
+		void *(*record)(void *user, size_t index), void *user, int threads);
+size_t cave_jsonc_get_batch_length(cave_jsonc_batch batch);
+cave_jsonc_document cave_jsonc_get_batch_document(cave_jsonc_batch batch, size_t index);
+size_t cave_jsonc_get_batch_line(cave_jsonc_batch batch, size_t index);
+/**
+ * 无法读取输入时返回保存错误的文档，否则返回NULL
+ */
+cave_jsonc_document cave_jsonc_get_batch_error(cave_jsonc_batch batch);
+int cave_jsonc_print_batch_error(cave_jsonc_batch batch, int (*fputc)(int c, void *file), void *file);
+/**
+ * 释放结果和其中所有的文档
+ */
+void cave_jsonc_release_batch(cave_jsonc_batch batch);
+/**
+ * 按事件解析，不构建树，内存占用只和嵌套深度有关
+ * 返回的文档只用于保存错误，没有根节点，用完后需要释放
+ */
+cave_jsonc_document cave_jsonc_parse_events(int (*fgetc)(void *file), void *file,
+		const cave_jsonc_sax_handler *handler, void *user);
+cave_jsonc_document cave_jsonc_parse_buffer_events(const char *data, size_t length,
+		const cave_jsonc_sax_handler *handler, void *user);
+cave_jsonc_document cave_jsonc_parser_parse_events(cave_jsonc_parser parser, int (*fgetc)(void *file), void *file,
+		const cave_jsonc_sax_handler *handler, void *user);
+cave_jsonc_document cave_jsonc_parser_parse_buffer_events(cave_jsonc_parser parser, const char *data, size_t length,
+		const cave_jsonc_sax_handler *handler, void *user);
+/**
+ * 创建推送式解析器，可以构建文档，也可以只发出事件
+ * 构建文档时输入块在送入后即可释放，所以CAVE_JSONC_DOCUMENT_BORROW不起作用
+ * cave_jsonc_push_feed返回非0表示解析已经因为错误或回调要求而停止，之后送入的内容会被忽略
+ * cave_jsonc_push_finish表示输入结束，释放解析器并返回文档，只发出事件时文档只保存错误
+ */
+cave_jsonc_push_parser cave_jsonc_create_push_parser(int flags);
+cave_jsonc_push_parser cave_jsonc_create_push_parser_with_handler(const cave_jsonc_sax_handler *handler, void *user);
+int cave_jsonc_push_feed(cave_jsonc_push_parser parser, const char *chunk, size_t length);
+cave_jsonc_document cave_jsonc_push_finish(cave_jsonc_push_parser parser);
+/**
+ * 解析为磁带，错误保存在cave_jsonc_get_tape_document返回的文档中，出错时根节点不存在
+ * 磁带持有这个文档，释放磁带时一起释放
+ */
+cave_jsonc_tape cave_jsonc_parse_tape(int (*fgetc)(void *file), void *file);
+cave_jsonc_tape cave_jsonc_parse_buffer_tape(const char *data, size_t length);
+cave_jsonc_tape cave_jsonc_parser_parse_tape(cave_jsonc_parser parser, int (*fgetc)(void *file), void *file);
+cave_jsonc_tape cave_jsonc_parser_parse_buffer_tape(cave_jsonc_parser parser, const char *data, size_t length);
+void cave_jsonc_release_tape(cave_jsonc_tape tape);
+cave_jsonc_document cave_jsonc_get_tape_document(cave_jsonc_tape tape);
+cave_jsonc_tape_value cave_jsonc_get_tape_root(cave_jsonc_tape tape);
+/**
+ * 不存在的值类型为CAVE_JSONC_UNDEFINED，其余访问函数要求类型正确
+ * 字符串以\0结尾，只要磁带没有释放就一直有效
+ */
+cave_jsonc_type cave_jsonc_get_tape_value_type(cave_jsonc_tape_value value);
+int cave_jsonc_get_tape_boolean(cave_jsonc_tape_value value);
+long long cave_jsonc_get_tape_integer(cave_jsonc_tape_value value);
+double cave_jsonc_get_tape_double(cave_jsonc_tape_value value);
+const char *cave_jsonc_get_tape_string(cave_jsonc_tape_value value, size_t *length);
+/**
+ * 数组的元素个数或对象的键值对个数
+ */
+size_t cave_jsonc_get_tape_length(cave_jsonc_tape_value value);
+/**
+ * 按顺序遍历数组，到达末尾时返回不存在的值
+ */
+cave_jsonc_tape_value cave_jsonc_get_tape_first_value(cave_jsonc_tape_value array);
+cave_jsonc_tape_value cave_jsonc_next_tape_value(cave_jsonc_tape_value value);
+/**
+ * 按顺序遍历对象的键值对，到达末尾时返回不存在的值
+ */
+cave_jsonc_tape_value cave_jsonc_get_tape_first_kvpair(cave_jsonc_tape_value object);
+cave_jsonc_tape_value cave_jsonc_next_tape_kvpair(cave_jsonc_tape_value pair);
+const char *cave_jsonc_get_tape_key(cave_jsonc_tape_value pair, size_t *length);
+cave_jsonc_tape_value cave_jsonc_get_tape_kvpair_value(cave_jsonc_tape_value pair);
+/**
+ * 按键查找，有重复的键时返回第一个
+ * 成员不少于8个的对象在构建磁带时建立哈希表，查找不随成员个数变慢，成员较少的对象逐个比较
+ */
+cave_jsonc_tape_value cave_jsonc_tape_object_get(cave_jsonc_tape_value object, const char *key, size_t length);
+/**
+ * 按下标取数组元素，越界时返回不存在的值
+ * 成员不少于8个的数组在构建磁带时记录每个元素的下标，直接查表，成员较少的数组依次跳过前面的元素
+ */
+cave_jsonc_tape_value cave_jsonc_tape_array_get(cave_jsonc_tape_value array, size_t index);
+/**
+ * 把文档转换为磁带，延迟解析的容器会先解析，数字只保留数值，位置和注释不保留
+ */
+cave_jsonc_tape cave_jsonc_document_to_tape(cave_jsonc_document doc);
+/**
+ * 磁带映像只包含下标和偏移，连同查找表一起保存，可以只读映射后直接查询，多个进程映射同一个文件时共享页缓存
+ * 映像使用本机字节序，只能在相同架构的机器上读取
+ * cave_jsonc_save_tape_image先写临时文件再改名，正在映射旧文件的进程不受影响
+ * cave_jsonc_map_tape_image总是返回磁带，文件无法映射或不是映像时根节点不存在，错误保存在磁带的文档中
+ */
+int cave_jsonc_write_tape_image(cave_jsonc_tape tape, size_t (*fwrite)(const void *data, size_t length, void *file), void *file);
+int cave_jsonc_save_tape_image(cave_jsonc_tape tape, const char *path);
+cave_jsonc_tape cave_jsonc_map_tape_image(const char *path);
 int cave_jsonc_serialize_document(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file, int mininize);
+int cave_jsonc_serialize_document_to_sink(cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int mininize);
+char *cave_jsonc_serialize_document_to_memory(cave_jsonc_document doc, int mininize, size_t *length);
+/**
+ * 使用给定的序列化器输出，行为和对应的不带序列化器的接口相同
+ */
+cave_jsonc_writer cave_jsonc_create_writer(void);
+void cave_jsonc_release_writer(cave_jsonc_writer writer);
+int cave_jsonc_writer_serialize_to_sink(cave_jsonc_writer writer, cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int mininize);
+char *cave_jsonc_writer_serialize_to_memory(cave_jsonc_writer writer, cave_jsonc_document doc, int mininize, size_t *length);
+/**
+ * 之后用这个序列化器输出时把统计累加到stats，NULL表示不统计，字段含义见cave_jsonc_stats
+ */
+void cave_jsonc_writer_set_stats(cave_jsonc_writer writer, cave_jsonc_stats *stats);
+/**
+ * 二进制格式的选项，可以按位组合
+ */
+typedef enum cave_jsonc_binary_option {
+	/**
+	 * 保存值和键的位置
+	 */
+	CAVE_JSONC_BINARY_POSITIONS = 1,
+	/**
+	 * 检查缓存时比较源文件内容的哈希，默认只比较大小和修改时间
+	 */
+	CAVE_JSONC_BINARY_VERIFY_HASH = 2,
+} cave_jsonc_binary_option;
+/**
+ * 把文档保存为紧凑的二进制格式，字符串带长度前缀，数字保存为原生的整数或double，注释不保存
+ */
+int cave_jsonc_serialize_document_to_binary(cave_jsonc_document doc,
+		size_t (*fwrite)(const void *data, size_t length, void *file), void *file, int options);
+char *cave_jsonc_serialize_document_to_binary_memory(cave_jsonc_document doc, int options, size_t *length);
+/**
+ * 读取二进制格式的文档，flags与解析文本时相同，数据损坏时报告致命错误并保留已经读出的部分
+ */
+cave_jsonc_document cave_jsonc_parse_binary(const char *data, size_t length, int flags);
+/**
+ * cache中的二进制缓存仍然新鲜时直接读取，否则解析path并在没有任何错误时重写缓存
+ */
+cave_jsonc_document cave_jsonc_load_file_cached(const char *path, const char *cache, int flags, int options);
 int cave_jsonc_print_error(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file);
 int cave_jsonc_print_error_full(cave_jsonc_document doc, int (*fputc)(int c, void *file), void *file,
 		const char *filename, int (*fseek)(void *, size_t, int), int (*fgetc)(void *file), void *in);
@@ -0,0 +1,704 @@
+/**
+ * 回归测试：树、事件和推送三种解析的结果一致，多线程和顺序解析一致，
+ * 二进制格式和磁带往返后内容不变，百万层的嵌套不会耗尽调用栈
+ * 编译运行：make test
+ * 每个失败的检查打印一行原因，全部通过时返回0
+ */
+#include "cavejsonc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+
+static int failures, checks;
+
+#define CHECK(condition, ...) do { \
+	checks++; \
+	if(!(condition)) { \
+		failures++; \
+		printf("%s:%d: ", __func__, __LINE__); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+	} \
+} while(0)
+
+static uint64_t state = 88172645463325252ull;
+
+static uint64_t next_random() {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+/**
+ * 可以自动扩展的缓冲区，生成输入和记录解析结果都用它
+ */
+struct buffer {
+	char *data;
+	size_t size, cap;
+};
+
+static void put(struct buffer *b, const char *s, size_t length) {
+	if(b->size + length + 1 > b->cap) {
+		while(b->size + length + 1 > b->cap)
+			b->cap = b->cap ? b->cap * 2 : 4096;
+		b->data = realloc(b->data, b->cap);
+	}
+	memcpy(b->data + b->size, s, length);
+	b->size += length;
+	b->data[b->size] = '\0';
+}
+
+static void puts_buffer(struct buffer *b, const char *s) {
+	put(b, s, strlen(s));
+}
+
+static void release(cave_jsonc_document doc) {
+	cave_jsonc_release_all_nodes_in_document(doc);
+	cave_jsonc_release_document(doc);
+}
+
+/**
+ * 生成的键有意重复，让对象中出现同名的键
+ */
+static const char *const keys[] = {"id", "name", "a", "b", "tags", "value", "x\\\"y", "\\u00e9t\\u00e9", "k\\n", ""};
+static const char *const strings[] = {
+	"", "plain", "with space", "esc\\\\aped\\/", "\\ud83d\\ude00", "tab\\there", "\\u0000nul", "中文",
+};
+static const char *const numbers[] = {
+	"0", "-0", "1", "-1", "42", "3.5", "-0.0", "1e10", "2.5E-3", "9223372036854775807", "-9223372036854775808",
+	"12345678901234567890", "0.1", "1e400", "-1e-400", "123456789.125",
+};
+
+static void space(struct buffer *b) {
+	switch(next_random() % 12) {
+		case 0:
+			puts_buffer(b, " ");
+			break;
+		case 1:
+			puts_buffer(b, "\n\t");
+			break;
+		case 2:
+			puts_buffer(b, " /* c */");
+			break;
+		case 3:
+			puts_buffer(b, " // line\n");
+			break;
+	}
+}
+
+/**
+ * 生成随机的合法文档，depth限制嵌套层数，有时生成成员较多的容器
+ * 解析器不接受紧跟在{或true等关键字之后的注释，注释前总有空格，对象的第一个键之前和空对象中不放注释
+ */
+static void random_value(struct buffer *b, int depth) {
+	int kind = depth > 0 ? next_random() % 8 : next_random() % 6;
+	space(b);
+	switch(kind) {
+		case 0:
+			puts_buffer(b, numbers[next_random() % (sizeof(numbers) / sizeof(numbers[0]))]);
+			break;
+		case 1:
+			puts_buffer(b, "\"");
+			puts_buffer(b, strings[next_random() % (sizeof(strings) / sizeof(strings[0]))]);
+			puts_buffer(b, "\"");
+			break;
+		case 2:
+			puts_buffer(b, "true");
+			break;
+		case 3:
+			puts_buffer(b, "false");
+			break;
+		case 4:
+			puts_buffer(b, "null");
+			break;
+		case 5: {
+			char text[32];
+			snprintf(text, sizeof(text), "%lld", (long long) (next_random() >> (next_random() % 64)) - (1ll << 40));
+			puts_buffer(b, text);
+			break;
+		}
+		case 6: {
+			size_t count = next_random() % 4 ? next_random() % 5 : 8 + next_random() % 24;
+			puts_buffer(b, "{");
+			for(size_t i = 0; i < count; i++) {
+				if(i) {
+					puts_buffer(b, ",");
+					space(b);
+				}
+				puts_buffer(b, "\"");
+				puts_buffer(b, keys[next_random() % (sizeof(keys) / sizeof(keys[0]))]);
+				if(next_random() % 2) {
+					char suffix[16];
+					snprintf(suffix, sizeof(suffix), "%d", (int) (next_random() % 16));
+					puts_buffer(b, suffix);
+				}
+				puts_buffer(b, "\":");
+				random_value(b, depth - 1);
+			}
+			puts_buffer(b, "}");
+			break;
+		}
+		default: {
+			size_t count = next_random() % 4 ? next_random() % 5 : 8 + next_random() % 24;
+			puts_buffer(b, "[");
+			for(size_t i = 0; i < count; i++) {
+				if(i)
+					puts_buffer(b, ",");
+				random_value(b, depth - 1);
+			}
+			space(b);
+			puts_buffer(b, "]");
+		}
+	}
+	space(b);
+}
+
+/**
+ * 把解析结果记录成与来源无关的事件序列，三种解析和两种往返都比较这个序列
+ * 数字按double的位模式记录，-0和0不同
+ */
+static void record_number(struct buffer *b, double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	char text[32];
+	snprintf(text, sizeof(text), "N%016llx", (unsigned long long) bits);
+	puts_buffer(b, text);
+}
+
+static void record_string(struct buffer *b, char tag, const char *value, size_t length) {
+	char text[32];
+	snprintf(text, sizeof(text), "%c%zu:", tag, length);
+	puts_buffer(b, text);
+	put(b, value, length);
+}
+
+static void record_value(struct buffer *b, cave_jsonc_value value) {
+	switch(cave_jsonc_get_value_type(value)) {
+		case CAVE_JSONC_NULL:
+			puts_buffer(b, "Z");
+			break;
+		case CAVE_JSONC_BOOLEAN:
+			puts_buffer(b, value->value.boolean ? "T" : "F");
+			break;
+		case CAVE_JSONC_NUMBER:
+			record_number(b, cave_jsonc_get_double(value));
+			break;
+		case CAVE_JSONC_STRING:
+			record_string(b, 'S', value->value.string->value, value->value.string->length);
+			break;
+		case CAVE_JSONC_OBJECT:
+			puts_buffer(b, "{");
+			for(cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(cave_jsonc_get_object(value)); pair;
+					pair = cave_jsonc_next_kvpair(pair)) {
+				record_string(b, 'K', pair->key->value, pair->key->length);
+				record_value(b, pair->value);
+			}
+			puts_buffer(b, "}");
+			break;
+		case CAVE_JSONC_ARRAY: {
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			puts_buffer(b, "[");
+			for(size_t i = 0; i < array->length; i++)
+				record_value(b, array->values[i]);
+			puts_buffer(b, "]");
+			break;
+		}
+		default:
+			puts_buffer(b, "?");
+	}
+}
+
+static void record_document(struct buffer *b, cave_jsonc_document doc) {
+	b->size = 0;
+	puts_buffer(b, "");
+	if(cave_jsonc_get_document_root(doc))
+		record_value(b, cave_jsonc_get_document_root(doc));
+}
+
+static int record_start_object(void *user, cave_jsonc_position position) {
+	puts_buffer(user, "{");
+	return 0;
+}
+
+static int record_end_object(void *user) {
+	puts_buffer(user, "}");
+	return 0;
+}
+
+static int record_start_array(void *user, cave_jsonc_position position) {
+	puts_buffer(user, "[");
+	return 0;
+}
+
+static int record_end_array(void *user) {
+	puts_buffer(user, "]");
+	return 0;
+}
+
+static int record_key(void *user, const char *key, size_t length, cave_jsonc_position position) {
+	record_string(user, 'K', key, length);
+	return 0;
+}
+
+static int record_string_event(void *user, const char *value, size_t length, cave_jsonc_position position) {
+	record_string(user, 'S', value, length);
+	return 0;
+}
+
+static int record_number_event(void *user, const cave_jsonc_sax_number *number, cave_jsonc_position position) {
+	record_number(user, number->fval);
+	return 0;
+}
+
+static int record_boolean(void *user, int value, cave_jsonc_position position) {
+	puts_buffer(user, value ? "T" : "F");
+	return 0;
+}
+
+static int record_null(void *user, cave_jsonc_position position) {
+	puts_buffer(user, "Z");
+	return 0;
+}
+
+static const cave_jsonc_sax_handler record_handler = {
+	record_start_object, record_end_object, record_start_array, record_end_array,
+	record_key, record_string_event, record_number_event, record_boolean, record_null,
+};
+
+static void record_tape_value(struct buffer *b, cave_jsonc_tape_value value) {
+	size_t length;
+	const char *text;
+	switch(cave_jsonc_get_tape_value_type(value)) {
+		case CAVE_JSONC_NULL:
+			puts_buffer(b, "Z");
+			break;
+		case CAVE_JSONC_BOOLEAN:
+			puts_buffer(b, cave_jsonc_get_tape_boolean(value) ? "T" : "F");
+			break;
+		case CAVE_JSONC_NUMBER:
+			record_number(b, cave_jsonc_get_tape_double(value));
+			break;
+		case CAVE_JSONC_STRING:
+			text = cave_jsonc_get_tape_string(value, &length);
+			record_string(b, 'S', text, length);
+			break;
+		case CAVE_JSONC_OBJECT:
+			puts_buffer(b, "{");
+			for(cave_jsonc_tape_value pair = cave_jsonc_get_tape_first_kvpair(value); pair.index;
+					pair = cave_jsonc_next_tape_kvpair(pair)) {
+				text = cave_jsonc_get_tape_key(pair, &length);
+				record_string(b, 'K', text, length);
+				record_tape_value(b, cave_jsonc_get_tape_kvpair_value(pair));
+			}
+			puts_buffer(b, "}");
+			break;
+		case CAVE_JSONC_ARRAY:
+			puts_buffer(b, "[");
+			for(cave_jsonc_tape_value item = cave_jsonc_get_tape_first_value(value); item.index;
+					item = cave_jsonc_next_tape_value(item))
+				record_tape_value(b, item);
+			puts_buffer(b, "]");
+			break;
+		default:
+			puts_buffer(b, "?");
+	}
+}
+
+static void record_tape(struct buffer *b, cave_jsonc_tape tape) {
+	b->size = 0;
+	puts_buffer(b, "");
+	cave_jsonc_tape_value root = cave_jsonc_get_tape_root(tape);
+	if(root.index)
+		record_tape_value(b, root);
+}
+
+/**
+ * 错误列表的文本，比较多线程和顺序解析时使用
+ */
+static void record_errors(struct buffer *b, cave_jsonc_document doc) {
+	b->size = 0;
+	puts_buffer(b, "");
+	for(cave_jsonc_error error = doc->error_head; error; error = error->next) {
+		char text[128];
+		snprintf(text, sizeof(text), "%d %ld:%ld:%ld ", error->fatal, (long) error->position.row,
+				(long) error->position.cols, (long) error->position.index);
+		puts_buffer(b, text);
+		puts_buffer(b, error->message);
+		puts_buffer(b, "\n");
+	}
+}
+
+/**
+ * 按随机大小的块推送，块可以只有一个字节，数字、转义和注释会被切开
+ */
+static cave_jsonc_document push_chunks(cave_jsonc_push_parser parser, const char *data, size_t length) {
+	for(size_t offset = 0; offset < length;) {
+		size_t chunk = 1 + next_random() % (next_random() % 2 ? 8 : 4096);
+		if(chunk > length - offset)
+			chunk = length - offset;
+		cave_jsonc_push_feed(parser, data + offset, chunk);
+		offset += chunk;
+	}
+	return cave_jsonc_push_finish(parser);
+}
+
+/**
+ * 输入有时截断或者改掉一个字节，三种解析是否出错必须一致，没有出错时事件序列必须相同
+ */
+static void test_parsers_agree() {
+	struct buffer text = {0}, tree = {0}, events = {0}, pushed = {0}, push_events = {0};
+	for(int round = 0; round < 3000; round++) {
+		text.size = 0;
+		random_value(&text, 1 + round % 5);
+		if(round % 3 == 1)
+			text.size = next_random() % (text.size + 1);
+		else if(round % 3 == 2 && text.size)
+			text.data[next_random() % text.size] = "{}[]:,\"\\/*-.0e"[next_random() % 14];
+		cave_jsonc_document doc = cave_jsonc_parse_buffer(text.data, text.size, 0);
+		record_document(&tree, doc);
+		events.size = 0;
+		puts_buffer(&events, "");
+		cave_jsonc_document event_doc = cave_jsonc_parse_buffer_events(text.data, text.size, &record_handler, &events);
+		cave_jsonc_document push_doc = push_chunks(cave_jsonc_create_push_parser(0), text.data, text.size);
+		record_document(&pushed, push_doc);
+		push_events.size = 0;
+		puts_buffer(&push_events, "");
+		cave_jsonc_document push_event_doc = push_chunks(
+				cave_jsonc_create_push_parser_with_handler(&record_handler, &push_events), text.data, text.size);
+		int fatal = cave_jsonc_has_fatal_error(doc);
+		CHECK(cave_jsonc_has_fatal_error(event_doc) == fatal && cave_jsonc_has_fatal_error(push_doc) == fatal &&
+				cave_jsonc_has_fatal_error(push_event_doc) == fatal, "是否出错不一致：%s", text.data);
+		if(!fatal) {
+			CHECK(!strcmp(tree.data, events.data), "事件解析不同：%s", text.data);
+			CHECK(!strcmp(tree.data, push_events.data), "推送的事件不同：%s", text.data);
+		}
+		// 推送构建的树在出错时也和拉取解析保留同样的部分
+		CHECK(!strcmp(tree.data, pushed.data), "推送构建的树不同：%s", text.data);
+		release(doc);
+		cave_jsonc_release_document(event_doc);
+		release(push_doc);
+		cave_jsonc_release_document(push_event_doc);
+	}
+	free(text.data);
+	free(tree.data);
+	free(events.data);
+	free(pushed.data);
+	free(push_events.data);
+}
+
+/**
+ * 输入要足够大，根容器的成员才会真的分给多个线程
+ */
+static void test_parallel() {
+	struct buffer text = {0}, sequential = {0}, parallel = {0};
+	for(int round = 0; round < 6; round++) {
+		text.size = 0;
+		puts_buffer(&text, round % 2 ? "{" : "[");
+		for(int i = 0; text.size < ((size_t) 3 << 20); i++) {
+			if(i)
+				puts_buffer(&text, ",");
+			if(round % 2) {
+				char key[32];
+				snprintf(key, sizeof(key), "\"k%d\":", i % 5000);
+				puts_buffer(&text, key);
+			}
+			random_value(&text, 3);
+		}
+		puts_buffer(&text, round % 2 ? "}" : "]");
+		if(round >= 4)// 中间的错误要和顺序解析报告在同一个位置
+			text.data[text.size / 2 + next_random() % 1000] = '}';
+		cave_jsonc_document doc = cave_jsonc_parse_buffer(text.data, text.size, 0);
+		cave_jsonc_document parallel_doc = cave_jsonc_parse_buffer_parallel(text.data, text.size, 0, 4);
+		record_document(&sequential, doc);
+		record_document(&parallel, parallel_doc);
+		CHECK(!strcmp(sequential.data, parallel.data), "第%d轮的树不同", round);
+		record_errors(&sequential, doc);
+		record_errors(&parallel, parallel_doc);
+		CHECK(!strcmp(sequential.data, parallel.data), "第%d轮的错误不同：\n%s---\n%s", round, sequential.data, parallel.data);
+		release(doc);
+		release(parallel_doc);
+	}
+	free(text.data);
+	free(sequential.data);
+	free(parallel.data);
+}
+
+/**
+ * 二进制往返后内容不变，任意截断都只报告错误
+ */
+static void test_binary_round_trip() {
+	struct buffer text = {0}, before = {0}, after = {0};
+	for(int round = 0; round < 500; round++) {
+		text.size = 0;
+		random_value(&text, 1 + round % 5);
+		cave_jsonc_document doc = cave_jsonc_parse_buffer(text.data, text.size, round % 2 ? CAVE_JSONC_DOCUMENT_RAW_NUMBER : 0);
+		record_document(&before, doc);
+		size_t length;
+		char *binary = cave_jsonc_serialize_document_to_binary_memory(doc, round % 4 < 2 ? CAVE_JSONC_BINARY_POSITIONS : 0, &length);
+		cave_jsonc_document copy = cave_jsonc_parse_binary(binary, length, 0);
+		record_document(&after, copy);
+		CHECK(!cave_jsonc_has_fatal_error(copy) && !strcmp(before.data, after.data), "往返后不同：%s", text.data);
+		release(copy);
+		if(round % 10 == 0) {
+			// 只有文件头的二进制文档是没有根节点的空文档
+			for(size_t cut = 0; cut < length; cut++) {
+				copy = cave_jsonc_parse_binary(binary, cut, 0);
+				CHECK(cave_jsonc_has_fatal_error(copy) || (cut == 40 && !cave_jsonc_get_document_root(copy)),
+						"截断到%zu字节没有报告错误：%s", cut, text.data);
+				release(copy);
+			}
+		}
+		free(binary);
+		release(doc);
+	}
+	free(text.data);
+	free(before.data);
+	free(after.data);
+}
+
+/**
+ * 按下标和按键查找的结果要与顺序遍历一致，同名的键返回第一个
+ */
+static void check_tape_lookup(cave_jsonc_tape_value value) {
+	size_t length, index = 0;
+	switch(cave_jsonc_get_tape_value_type(value)) {
+		case CAVE_JSONC_ARRAY:
+			for(cave_jsonc_tape_value item = cave_jsonc_get_tape_first_value(value); item.index;
+					item = cave_jsonc_next_tape_value(item), index++) {
+				CHECK(cave_jsonc_tape_array_get(value, index).index == item.index, "数组的第%zu个元素不同", index);
+				check_tape_lookup(item);
+			}
+			CHECK(cave_jsonc_get_tape_length(value) == index && !cave_jsonc_tape_array_get(value, index).index,
+					"数组长度不同");
+			break;
+		case CAVE_JSONC_OBJECT:
+			for(cave_jsonc_tape_value pair = cave_jsonc_get_tape_first_kvpair(value); pair.index;
+					pair = cave_jsonc_next_tape_kvpair(pair), index++) {
+				const char *key = cave_jsonc_get_tape_key(pair, &length);
+				cave_jsonc_tape_value first = cave_jsonc_get_tape_first_kvpair(value);
+				for(size_t other; ; first = cave_jsonc_next_tape_kvpair(first)) {
+					const char *other_key = cave_jsonc_get_tape_key(first, &other);
+					if(other == length && !memcmp(other_key, key, length))
+						break;
+				}
+				CHECK(cave_jsonc_tape_object_get(value, key, length).index == cave_jsonc_get_tape_kvpair_value(first).index,
+						"按键%s查找的结果不同", key);
+				check_tape_lookup(cave_jsonc_get_tape_kvpair_value(pair));
+			}
+			CHECK(cave_jsonc_get_tape_length(value) == index && !cave_jsonc_tape_object_get(value, "\1", 1).index,
+					"对象长度不同");
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * 解析为磁带、从文档转换为磁带以及保存映像再映射，三者的内容都与树相同
+ * 映像改掉任何一个字节后要么被拒绝，要么仍然可以安全地遍历
+ */
+static void test_tape_round_trip() {
+	struct buffer text = {0}, tree = {0}, tape_text = {0};
+	char path[] = "test_suite.img.XXXXXX";
+	int fd = mkstemp(path);
+	if(fd >= 0)
+		close(fd);
+	CHECK(fd >= 0, "不能创建临时文件");
+	for(int round = 0; round < 500 && fd >= 0; round++) {
+		text.size = 0;
+		random_value(&text, 1 + round % 5);
+		cave_jsonc_document doc = cave_jsonc_parse_buffer(text.data, text.size, 0);
+		record_document(&tree, doc);
+		cave_jsonc_tape tapes[3];
+		tapes[0] = cave_jsonc_parse_buffer_tape(text.data, text.size);
+		tapes[1] = cave_jsonc_document_to_tape(doc);
+		CHECK(!cave_jsonc_save_tape_image(tapes[0], path), "不能保存映像");
+		tapes[2] = cave_jsonc_map_tape_image(path);
+		for(int i = 0; i < 3; i++) {
+			record_tape(&tape_text, tapes[i]);
+			CHECK(!strcmp(tree.data, tape_text.data), "第%d种磁带不同：%s", i, text.data);
+			check_tape_lookup(cave_jsonc_get_tape_root(tapes[i]));
+		}
+		if(round % 25 == 0) {
+			FILE *file = fopen(path, "rb");
+			struct buffer image = {0};
+			char chunk[4096];
+			size_t n;
+			while(file && (n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+				put(&image, chunk, n);
+			if(file)
+				fclose(file);
+			for(size_t i = 0; i < image.size; i += 1 + i / 64) {
+				char bit = 1 << (next_random() % 8);
+				image.data[i] ^= bit;
+				file = fopen(path, "wb");
+				fwrite(image.data, 1, image.size, file);
+				fclose(file);
+				cave_jsonc_tape mapped = cave_jsonc_map_tape_image(path);
+				record_tape(&tape_text, mapped);
+				check_tape_lookup(cave_jsonc_get_tape_root(mapped));
+				cave_jsonc_release_tape(mapped);
+				image.data[i] ^= bit;
+			}
+			free(image.data);
+		}
+		for(int i = 0; i < 3; i++)
+			cave_jsonc_release_tape(tapes[i]);
+		release(doc);
+	}
+	if(fd >= 0)
+		unlink(path);
+	free(text.data);
+	free(tree.data);
+	free(tape_text.data);
+}
+
+/**
+ * 一百万层交替嵌套的数组和对象，解析、事件、推送、二进制和磁带都不能递归
+ * 测试自己也只沿着唯一的路径向下走，不递归
+ */
+#define DEEP_LEVELS 1000000
+
+static size_t deep_depth(cave_jsonc_value value) {
+	size_t depth = 0;
+	while(value) {
+		depth++;
+		if(cave_jsonc_get_value_type(value) == CAVE_JSONC_ARRAY) {
+			cave_jsonc_array array = cave_jsonc_get_array(value);
+			value = array->length ? array->values[0] : NULL;
+		} else if(cave_jsonc_get_value_type(value) == CAVE_JSONC_OBJECT) {
+			cave_jsonc_kvpair pair = cave_jsonc_get_first_kvpair(cave_jsonc_get_object(value));
+			value = pair ? pair->value : NULL;
+		} else
+			break;
+	}
+	return depth;
+}
+
+static size_t deep_tape_depth(cave_jsonc_tape_value value) {
+	size_t depth = 0;
+	while(value.index) {
+		depth++;
+		if(cave_jsonc_get_tape_value_type(value) == CAVE_JSONC_ARRAY)
+			value = cave_jsonc_get_tape_first_value(value);
+		else if(cave_jsonc_get_tape_value_type(value) == CAVE_JSONC_OBJECT) {
+			cave_jsonc_tape_value pair = cave_jsonc_get_tape_first_kvpair(value);
+			value = pair.index ? cave_jsonc_get_tape_kvpair_value(pair) : pair;
+		} else
+			break;
+	}
+	return depth;
+}
+
+static int count_event(void *user, cave_jsonc_position position) {
+	(*(size_t *) user)++;
+	return 0;
+}
+
+static void test_deep_nesting() {
+	struct buffer text = {0};
+	for(int i = 0; i < DEEP_LEVELS; i++)
+		puts_buffer(&text, i % 2 ? "{\"k\":" : "[");
+	puts_buffer(&text, "0");
+	for(int i = DEEP_LEVELS - 1; i >= 0; i--)
+		puts_buffer(&text, i % 2 ? "}" : "]");
+	// 值不能逐个释放，逐个释放对象时会递归，这里用arena整块释放
+	cave_jsonc_document doc = cave_jsonc_parse_buffer(text.data, text.size, CAVE_JSONC_DOCUMENT_ARENA);
+	CHECK(!cave_jsonc_has_fatal_error(doc) && deep_depth(cave_jsonc_get_document_root(doc)) == DEEP_LEVELS + 1,
+			"树的层数不对");
+	size_t containers = 0;
+	cave_jsonc_sax_handler handler = {0};
+	handler.start_object = count_event;
+	handler.start_array = count_event;
+	cave_jsonc_document event_doc = cave_jsonc_parse_buffer_events(text.data, text.size, &handler, &containers);
+	CHECK(!cave_jsonc_has_fatal_error(event_doc) && containers == DEEP_LEVELS, "事件的容器个数不对");
+	cave_jsonc_release_document(event_doc);
+	cave_jsonc_push_parser parser = cave_jsonc_create_push_parser(CAVE_JSONC_DOCUMENT_ARENA);
+	cave_jsonc_document push_doc = push_chunks(parser, text.data, text.size);
+	CHECK(!cave_jsonc_has_fatal_error(push_doc) && deep_depth(cave_jsonc_get_document_root(push_doc)) == DEEP_LEVELS + 1,
+			"推送构建的树的层数不对");
+	release(push_doc);
+	size_t length;
+	char *binary = cave_jsonc_serialize_document_to_binary_memory(doc, CAVE_JSONC_BINARY_POSITIONS, &length);
+	cave_jsonc_document copy = cave_jsonc_parse_binary(binary, length, CAVE_JSONC_DOCUMENT_ARENA);
+	CHECK(!cave_jsonc_has_fatal_error(copy) && deep_depth(cave_jsonc_get_document_root(copy)) == DEEP_LEVELS + 1,
+			"二进制往返后的层数不对");
+	release(copy);
+	free(binary);
+	cave_jsonc_tape tape = cave_jsonc_parse_buffer_tape(text.data, text.size);
+	CHECK(deep_tape_depth(cave_jsonc_get_tape_root(tape)) == DEEP_LEVELS + 1, "磁带的层数不对");
+	cave_jsonc_release_tape(tape);
+	tape = cave_jsonc_document_to_tape(doc);
+	CHECK(deep_tape_depth(cave_jsonc_get_tape_root(tape)) == DEEP_LEVELS + 1, "文档转换的磁带的层数不对");
+	cave_jsonc_release_tape(tape);
+	release(doc);
+	free(text.data);
+}
+
+/**
+ * cave_jsonc_compile_path严格按照RFC 6901，通配符只在选项中打开
+ */
+static void test_path_syntax() {
+	const char *text = "{\"a\":{\"*\":1,\"x\":2},\"b\":[3,4]}";
+	cave_jsonc_document doc = cave_jsonc_parse_buffer(text, strlen(text), 0);
+	cave_jsonc_value root = cave_jsonc_get_document_root(doc), results[4];
+	CHECK(!cave_jsonc_compile_path("/a/~2", 5), "~2不是RFC 6901的转义");
+	CHECK(!cave_jsonc_compile_path("/a/~", 4), "~之后必须是0或1");
+	cave_jsonc_path path = cave_jsonc_compile_path("/a/*", 4);
+	CHECK(cave_jsonc_path_query(path, root, results, 4) == 1 && cave_jsonc_get_integer(results[0]) == 1, "*应当是普通的键");
+	cave_jsonc_release_path(path);
+	path = cave_jsonc_compile_path_with_options("/a/*", 4, CAVE_JSONC_PATH_WILDCARD);
+	CHECK(cave_jsonc_path_query(path, root, results, 4) == 2, "通配符应当匹配所有成员");
+	cave_jsonc_release_path(path);
+	path = cave_jsonc_compile_path_with_options("/a/~2", 5, CAVE_JSONC_PATH_WILDCARD);
+	CHECK(path && cave_jsonc_get_integer(cave_jsonc_path_get(path, root)) == 1, "~2应当表示字面的*");
+	cave_jsonc_release_path(path);
+	release(doc);
+}
+
+/**
+ * -0在文本、二进制和推送解析中都保留符号
+ */
+static void test_negative_zero() {
+	cave_jsonc_document doc = cave_jsonc_parse_buffer("-0", 2, 0);
+	size_t length;
+	char *text = cave_jsonc_serialize_document_to_memory(doc, 1, &length);
+	CHECK(signbit(cave_jsonc_get_double(cave_jsonc_get_document_root(doc))), "解析丢失了-0的符号");
+	release(doc);
+	doc = cave_jsonc_parse_buffer(text, length, 0);
+	CHECK(signbit(cave_jsonc_get_double(cave_jsonc_get_document_root(doc))), "-0序列化为%s，再解析时丢失了符号", text);
+	free(text);
+	release(doc);
+	cave_jsonc_push_parser parser = cave_jsonc_create_push_parser(0);
+	cave_jsonc_push_feed(parser, "-0", 2);
+	doc = cave_jsonc_push_finish(parser);
+	CHECK(signbit(cave_jsonc_get_double(cave_jsonc_get_document_root(doc))), "推送解析丢失了-0的符号");
+	release(doc);
+}
+
+static const struct {
+	const char *name;
+	void (*run)();
+} tests[] = {
+	{"parsers_agree", test_parsers_agree},
+	{"parallel", test_parallel},
+	{"binary_round_trip", test_binary_round_trip},
+	{"tape_round_trip", test_tape_round_trip},
+	{"deep_nesting", test_deep_nesting},
+	{"path_syntax", test_path_syntax},
+	{"negative_zero", test_negative_zero},
+};
+
+int main() {
+	for(size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+		int before = failures;
+		tests[i].run();
+		printf("%-20s %s\n", tests[i].name, failures == before ? "ok" : "FAILED");
+	}
+	printf("%d个检查，%d个失败\n", checks, failures);
+	return failures != 0;
+}